@@ -0,0 +1,146 @@
+#ifndef BENCHMARKS_BENCH_H_
+#define BENCHMARKS_BENCH_H_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Keeps the compiler from dropping a computed value
+template <typename T>
+inline void keep(T&& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Nanoseconds per iteration of the fastest of the repeats
+inline double measure(size_t iterations, const std::function<void()>& fn,
+                      size_t repeats = 5) {
+  double best = 0.0;
+  for (size_t r = 0; r < repeats; ++r) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) fn();
+    std::chrono::duration<double, std::nano> time =
+        std::chrono::steady_clock::now() - start;
+    double perOp = time.count() / iterations;
+    if (r == 0 || perOp < best) best = perOp;
+  }
+  return best;
+}
+
+// Pairs of a library benchmark and its raw C API baseline. The setup runs
+// before every repeat, so both sides start from the same state.
+class Suite {
+ public:
+  struct Case {
+    std::string name;
+    size_t iterations;
+    std::function<void()> setup;
+    std::function<void()> wrapped;
+    std::function<void()> raw;
+  };
+
+  explicit Suite(std::string filter) : filter(std::move(filter)) {}
+
+  void add(Case&& c) { cases.push_back(std::move(c)); }
+
+  void run(std::ostream& stream) const {
+    stream << std::left << std::setw(24) << "benchmark" << std::right
+           << std::setw(14) << "sqlpp ns/op" << std::setw(14) << "raw ns/op"
+           << std::setw(10) << "ratio" << "\n";
+    stream << std::fixed << std::setprecision(1);
+    for (const auto& c : cases) {
+      if (c.name.find(filter) == std::string::npos) continue;
+      auto wrapped = timed(c, c.wrapped);
+      auto raw = timed(c, c.raw);
+      stream << std::left << std::setw(24) << c.name << std::right
+             << std::setw(14) << wrapped << std::setw(14) << raw
+             << std::setw(10) << std::setprecision(2) << wrapped / raw
+             << std::setprecision(1) << "\n";
+    }
+  }
+
+ private:
+  static double timed(const Case& c, const std::function<void()>& fn) {
+    double best = 0.0;
+    for (int r = 0; r < 5; ++r) {
+      if (c.setup) c.setup();
+      auto perOp = measure(c.iterations, fn, 1);
+      if (r == 0 || perOp < best) best = perOp;
+    }
+    return best;
+  }
+
+  std::string filter;
+  std::vector<Case> cases;
+};
+
+// Latency histogram with power of two microsecond buckets, merged from the
+// per thread histograms at the end of a run
+class Histogram {
+ public:
+  static constexpr size_t BUCKETS = 32;
+
+  void add(std::chrono::nanoseconds time) {
+    uint64_t us = std::max<int64_t>(time.count() / 1000, 0);
+    size_t bucket = 0;
+    while (bucket + 1 < BUCKETS && (uint64_t(1) << bucket) <= us) ++bucket;
+    ++buckets[bucket];
+    ++total;
+    sum += time;
+    max = std::max(max, time);
+  }
+
+  void merge(const Histogram& other) {
+    for (size_t i = 0; i < BUCKETS; ++i) buckets[i] += other.buckets[i];
+    total += other.total;
+    sum += other.sum;
+    max = std::max(max, other.max);
+  }
+
+  uint64_t count() const { return total; }
+
+  // Upper bound of the bucket holding the quantile, in microseconds
+  uint64_t quantile(double q) const {
+    uint64_t rank = static_cast<uint64_t>(q * total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+      seen += buckets[i];
+      if (seen > rank) return uint64_t(1) << i;
+    }
+    return uint64_t(1) << (BUCKETS - 1);
+  }
+
+  double meanUs() const {
+    return total ? sum.count() / 1000.0 / total : 0.0;
+  }
+
+  double maxUs() const { return max.count() / 1000.0; }
+
+  // One line per non empty bucket: "< 64us  1234  ####"
+  void print(std::ostream& stream) const {
+    uint64_t top = *std::max_element(buckets.begin(), buckets.end());
+    for (size_t i = 0; i < BUCKETS; ++i) {
+      if (buckets[i] == 0) continue;
+      stream << "    < " << std::setw(9) << (uint64_t(1) << i) << "us "
+             << std::setw(10) << buckets[i] << " "
+             << std::string(top ? 40 * buckets[i] / top : 0, '#') << "\n";
+    }
+  }
+
+ private:
+  std::array<uint64_t, BUCKETS> buckets{};
+  uint64_t total = 0;
+  std::chrono::nanoseconds sum{0};
+  std::chrono::nanoseconds max{0};
+};
+
+}  // namespace bench
+
+#endif /* BENCHMARKS_BENCH_H_ */
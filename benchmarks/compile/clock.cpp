@@ -0,0 +1,11 @@
+#include <chrono>
+#include <iostream>
+
+// Prints the wall clock in milliseconds. time_compile.cmake runs it around
+// every compilation, string(TIMESTAMP) has no subsecond format before 3.23.
+int main() {
+  using namespace std::chrono;
+  auto now = system_clock::now().time_since_epoch();
+  std::cout << duration_cast<milliseconds>(now).count() << std::endl;
+  return 0;
+}
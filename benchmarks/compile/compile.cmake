@@ -0,0 +1,33 @@
+# Compile-time benchmarks, every case compiles compile/scaling.cpp with its
+# definition set. "compile_benchmarks" compiles them one after the other with
+# the benchmark flags, prints the times and appends them to compile_times.csv
+# in the build directory so that the numbers can be compared across commits.
+set(COMPILE_BENCHMARKS "")
+
+macro(add_compile_benchmark BENCHMARK_NAME DEFINITION)
+    list(APPEND COMPILE_BENCHMARKS ${BENCHMARK_NAME}=${DEFINITION})
+endmacro(add_compile_benchmark)
+
+add_compile_benchmark(includes_only SCALING_NONE)
+add_compile_benchmark(wide_table SCALING_WIDE_TABLE)
+add_compile_benchmark(six_table_join SCALING_JOIN)
+add_compile_benchmark(expression_chain SCALING_EXPRESSION_CHAIN)
+
+string(REPLACE ";" " " COMPILE_BENCHMARK_CASES "${COMPILE_BENCHMARKS}")
+
+add_executable(compile_clock compile/clock.cpp)
+
+add_custom_target(compile_benchmarks
+    COMMAND ${CMAKE_COMMAND}
+        -DCOMPILER=${CMAKE_CXX_COMPILER}
+        "-DFLAGS=${CMAKE_CXX_FLAGS} -I${CMAKE_SOURCE_DIR}/source"
+        -DSOURCE=${CMAKE_CURRENT_SOURCE_DIR}/compile/scaling.cpp
+        "-DCASES=${COMPILE_BENCHMARK_CASES}"
+        -DOUTPUT=${CMAKE_CURRENT_BINARY_DIR}/compile
+        -DLOG=${CMAKE_BINARY_DIR}/compile_times.csv
+        -DCLOCK=$<TARGET_FILE:compile_clock>
+        -P ${CMAKE_CURRENT_SOURCE_DIR}/compile/time_compile.cmake
+    DEPENDS compile_clock
+    VERBATIM
+    USES_TERMINAL
+)
@@ -0,0 +1,115 @@
+// Compile-time scaling cases, built one at a time by compile.cmake. The code
+// is never run, only the time taken to instantiate it matters.
+#include <sqlpp.h>
+
+#include <tuple>
+#include <utility>
+
+namespace {
+
+constexpr size_t WIDE_COLUMNS = 120;
+constexpr size_t JOIN_COLUMNS = 20;
+constexpr size_t CHAIN_LENGTH = 40;
+
+template <size_t I>
+using ColumnType =
+    std::tuple_element_t<I % 3, std::tuple<sqlpp::Integer, sqlpp::Text,
+                                           sqlpp::Real>>;
+
+template <typename T, typename S>
+struct GeneratedTableS;
+
+template <typename T, size_t... I>
+struct GeneratedTableS<T, std::index_sequence<I...>> {
+  using Type = sqlpp::Table<T, ColumnType<I>...>;
+};
+
+template <typename T, size_t N>
+using GeneratedTable =
+    typename GeneratedTableS<T, std::make_index_sequence<N>>::Type;
+
+template <size_t... I>
+std::array<std::string, sizeof...(I)> generatedNames(
+    std::index_sequence<I...>) {
+  return {("c" + std::to_string(I))...};
+}
+
+class Wide final : public GeneratedTable<Wide, WIDE_COLUMNS> {
+ public:
+  Wide()
+      : Table("Wide",
+              generatedNames(std::make_index_sequence<WIDE_COLUMNS>())) {}
+};
+
+template <size_t N>
+class Joined final : public GeneratedTable<Joined<N>, JOIN_COLUMNS> {
+ public:
+  Joined()
+      : GeneratedTable<Joined<N>, JOIN_COLUMNS>(
+            "Joined" + std::to_string(N),
+            generatedNames(std::make_index_sequence<JOIN_COLUMNS>())) {}
+};
+
+#ifdef SCALING_WIDE_TABLE
+template <size_t... I>
+void wideTable(const Wide& w, std::index_sequence<I...>) {
+  sqlpp::Database db(":memory:");
+  sqlpp::createTable(w).execute(db);
+  sqlpp::insertInto(w).values(Wide::Field<I>()...).execute(db);
+  sqlpp::select(w).executeT(db);
+  sqlpp::select(w.template column<I>()...).executeT(db);
+}
+#endif
+
+#ifdef SCALING_JOIN
+template <size_t... I>
+void join(std::index_sequence<I...>) {
+  sqlpp::Database db(":memory:");
+  Joined<0> t0;
+  Joined<1> t1;
+  Joined<2> t2;
+  Joined<3> t3;
+  Joined<4> t4;
+  Joined<5> t5;
+  sqlpp::select(t0.template column<I>()..., t1.template column<I>()...,
+                t2.template column<I>()..., t3.template column<I>()...,
+                t4.template column<I>()..., t5.template column<I>()...)
+      .join(t1)
+      .on(t1.column<0>() == t0.column<0>())
+      .join(t2)
+      .on(t2.column<0>() == t1.column<0>())
+      .join(t3)
+      .on(t3.column<0>() == t2.column<0>())
+      .join(t4)
+      .on(t4.column<0>() == t3.column<0>())
+      .join(t5)
+      .on(t5.column<0>() == t4.column<0>())
+      .where(t0.column<3>() > 0 && t5.column<3>() < 100)
+      .executeT(db);
+}
+#endif
+
+#ifdef SCALING_EXPRESSION_CHAIN
+template <size_t... I>
+void expressionChain(const Wide& w, std::index_sequence<I...>) {
+  sqlpp::Database db(":memory:");
+  sqlpp::select((w.template column<I * 3>() + ...))
+      .where(((w.template column<I * 3>() > 0) && ...))
+      .executeT(db);
+}
+#endif
+
+}  // namespace
+
+void scaling() {
+  Wide w;
+#ifdef SCALING_WIDE_TABLE
+  wideTable(w, std::make_index_sequence<WIDE_COLUMNS>());
+#endif
+#ifdef SCALING_JOIN
+  join(std::make_index_sequence<JOIN_COLUMNS>());
+#endif
+#ifdef SCALING_EXPRESSION_CHAIN
+  expressionChain(w, std::make_index_sequence<CHAIN_LENGTH>());
+#endif
+}
@@ -0,0 +1,54 @@
+# Times the compilation of every case, run by the compile_benchmarks target:
+#   cmake -DCOMPILER=... -DFLAGS=... -DSOURCE=... -DCASES="name=DEFINE ..."
+#         -DOUTPUT=... -DLOG=... -DCLOCK=... -P time_compile.cmake
+# CLOCK is the compile_clock tool printing the time in milliseconds
+cmake_minimum_required(VERSION 3.16.3)
+
+separate_arguments(FLAGS UNIX_COMMAND "${FLAGS}")
+separate_arguments(CASES UNIX_COMMAND "${CASES}")
+file(MAKE_DIRECTORY ${OUTPUT})
+
+if(EXISTS ${LOG})
+    file(STRINGS ${LOG} HISTORY)
+else()
+    file(WRITE ${LOG} "date,case,milliseconds\n")
+    set(HISTORY "")
+endif()
+
+string(TIMESTAMP DATE "%Y-%m-%dT%H:%M:%S")
+
+foreach(CASE ${CASES})
+    string(REPLACE "=" ";" CASE ${CASE})
+    list(GET CASE 0 NAME)
+    list(GET CASE 1 DEFINITION)
+
+    execute_process(COMMAND ${CLOCK} OUTPUT_VARIABLE START
+        OUTPUT_STRIP_TRAILING_WHITESPACE)
+    execute_process(
+        COMMAND ${COMPILER} ${FLAGS} -D${DEFINITION}=1
+            -c ${SOURCE} -o ${OUTPUT}/${NAME}.o
+        RESULT_VARIABLE RESULT
+    )
+    execute_process(COMMAND ${CLOCK} OUTPUT_VARIABLE END
+        OUTPUT_STRIP_TRAILING_WHITESPACE)
+    if(NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "${NAME}: compilation failed")
+    endif()
+    math(EXPR MILLISECONDS "${END} - ${START}")
+
+    # Compare with the last recorded run of the same case
+    set(PREVIOUS "")
+    foreach(LINE ${HISTORY})
+        if(LINE MATCHES "^[^,]*,${NAME},([0-9]+)$")
+            set(PREVIOUS ${CMAKE_MATCH_1})
+        endif()
+    endforeach()
+    if(PREVIOUS)
+        math(EXPR DELTA "${MILLISECONDS} - ${PREVIOUS}")
+        message("${NAME}: ${MILLISECONDS} ms (last ${PREVIOUS} ms, ${DELTA})")
+    else()
+        message("${NAME}: ${MILLISECONDS} ms")
+    endif()
+
+    file(APPEND ${LOG} "${DATE},${NAME},${MILLISECONDS}\n")
+endforeach()
@@ -0,0 +1,256 @@
+#include <sqlite3.h>
+#include <sqlpp.h>
+
+#include <cstring>
+#include <sstream>
+
+#include "bench.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+struct Point {
+  int x = 0;
+  int y = 0;
+};
+
+namespace sqlpp {
+
+template <>
+struct Converter<Point> {
+  using DbType = Blob;
+  static Blob toDb(const Point& value) {
+    Blob res(sizeof(Point));
+    memcpy(res.data(), &value, sizeof(Point));
+    return res;
+  }
+  static Point fromDb(const Blob& value) {
+    Point res;
+    if (value.size() == sizeof(Point))
+      memcpy(&res, value.data(), sizeof(Point));
+    return res;
+  }
+};
+
+}  // namespace sqlpp
+
+class Row final : public Table<Row, int, std::string, double> {
+ public:
+  Row() : Table("Rows", {"id", "name", "value"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> value = column<2>();
+};
+
+class Shape final : public Table<Shape, int, Point> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0>;
+
+  Shape() : Table("Shapes", {"id", "point"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> point = column<1>();
+};
+
+static constexpr int ROWS = 10000;
+
+static void exec(sqlite3* db, const char* sql) {
+  if (sqlite3_exec(db, sql, nullptr, nullptr, nullptr) != SQLITE_OK)
+    throw std::runtime_error(sqlite3_errmsg(db));
+}
+
+static sqlite3_stmt* prepare(sqlite3* db, const std::string& sql) {
+  sqlite3_stmt* stmt = nullptr;
+  if (sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    throw std::runtime_error(sqlite3_errmsg(db));
+  return stmt;
+}
+
+static void fill(Database& db) {
+  exec(db.handle(), "DELETE FROM Rows");
+  exec(db.handle(), "BEGIN");
+  auto stmt = prepare(db.handle(), "INSERT INTO Rows VALUES (?, ?, ?)");
+  for (int i = 0; i < ROWS; ++i) {
+    auto name = "row" + std::to_string(i);
+    sqlite3_bind_int64(stmt, 1, i);
+    sqlite3_bind_text(stmt, 2, name.c_str(), name.size(), SQLITE_TRANSIENT);
+    sqlite3_bind_double(stmt, 3, i * 0.5);
+    sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
+  exec(db.handle(), "COMMIT");
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  auto raw = db.handle();
+  Row r;
+  Shape s;
+  createTable(r).execute(db);
+  createTable(s).execute(db);
+
+  bench::Suite suite(argc > 1 ? argv[1] : "");
+
+  // Raw baselines of building and rendering assemble the same SQL by hand
+  suite.add({"build expression", 100000, nullptr,
+             [&] {
+               auto c = (r.id == 0 && r.value > 1.5) || r.name != "x"s;
+               bench::keep(c);
+             },
+             [&] {
+               std::string sql = "Rows.id = ? AND Rows.value > ? OR "
+                                 "Rows.name <> ?";
+               std::vector<std::string> binds{"0", "1.5", "x"};
+               bench::keep(sql);
+               bench::keep(binds);
+             }});
+
+  auto query = select(r.name, r.value)
+                   .where((r.id == 0 && r.value > 1.5) || r.name != "x"s)
+                   .orderBy(r.value);
+  suite.add({"render select", 100000, nullptr,
+             [&] {
+               std::ostringstream ss;
+               ss << query;
+               bench::keep(ss);
+             },
+             [&] {
+               std::string sql = "SELECT Rows.name, Rows.value FROM Rows";
+               sql += " WHERE Rows.id = ? AND Rows.value > ? OR Rows.name "
+                      "<> ?";
+               sql += " ORDER BY Rows.value";
+               bench::keep(sql);
+             }});
+
+  int next = 0;
+  auto clear = [&] {
+    exec(raw, "DELETE FROM Rows");
+    next = 0;
+  };
+  suite.add({"insert row", 20000, clear,
+             [&] {
+               insertInto(r).values(next++, "name"s, 1.5).execute(db);
+             },
+             [&] {
+               auto stmt = prepare(raw, "INSERT INTO Rows VALUES (?, ?, ?)");
+               sqlite3_bind_int64(stmt, 1, next++);
+               sqlite3_bind_text(stmt, 2, "name", 4, SQLITE_TRANSIENT);
+               sqlite3_bind_double(stmt, 3, 1.5);
+               sqlite3_step(stmt);
+               sqlite3_finalize(stmt);
+             }});
+
+  // 100 rows per transaction, the raw side reuses its prepared statement
+  suite.add({"insert batch of 100", 200, clear,
+             [&] {
+               db.execute("BEGIN");
+               for (int i = 0; i < 100; ++i)
+                 insertInto(r).values(next++, "name"s, 1.5).execute(db);
+               db.execute("COMMIT");
+             },
+             [&] {
+               exec(raw, "BEGIN");
+               auto stmt = prepare(raw, "INSERT INTO Rows VALUES (?, ?, ?)");
+               for (int i = 0; i < 100; ++i) {
+                 sqlite3_bind_int64(stmt, 1, next++);
+                 sqlite3_bind_text(stmt, 2, "name", 4, SQLITE_TRANSIENT);
+                 sqlite3_bind_double(stmt, 3, 1.5);
+                 sqlite3_step(stmt);
+                 sqlite3_reset(stmt);
+               }
+               sqlite3_finalize(stmt);
+               exec(raw, "COMMIT");
+             }});
+
+  // The insert cases above clear the table, both sides of the reads below
+  // start from the same ROWS rows
+  exec(raw, "CREATE INDEX IF NOT EXISTS rows_id ON Rows(id)");
+  int key = 0;
+  auto filled = [&] {
+    fill(db);
+    key = 0;
+  };
+  suite.add({"point select", 50000, filled,
+             [&] {
+               auto res = select(r.name, r.value)
+                              .where(r.id == key++ % ROWS)
+                              .executeT(db);
+               bench::keep(res.get<0>());
+               bench::keep(res.get<1>());
+             },
+             [&] {
+               auto stmt = prepare(raw,
+                                   "SELECT Rows.name, Rows.value FROM Rows "
+                                   "WHERE Rows.id = ?");
+               sqlite3_bind_int64(stmt, 1, key++ % ROWS);
+               if (sqlite3_step(stmt) == SQLITE_ROW) {
+                 std::string name(reinterpret_cast<const char*>(
+                     sqlite3_column_text(stmt, 0)));
+                 double value = sqlite3_column_double(stmt, 1);
+                 bench::keep(name);
+                 bench::keep(value);
+               }
+               sqlite3_finalize(stmt);
+             }});
+
+  suite.add({"scan decode 10000 rows", 20, filled,
+             [&] {
+               auto res = select(r).executeT(db);
+               for (; res.hasData(); res.next()) {
+                 bench::keep(res.get<0>());
+                 bench::keep(res.get<1>());
+                 bench::keep(res.get<2>());
+               }
+             },
+             [&] {
+               auto stmt = prepare(raw, "SELECT * FROM Rows");
+               while (sqlite3_step(stmt) == SQLITE_ROW) {
+                 int id = sqlite3_column_int(stmt, 0);
+                 std::string name(reinterpret_cast<const char*>(
+                     sqlite3_column_text(stmt, 1)));
+                 double value = sqlite3_column_double(stmt, 2);
+                 bench::keep(id);
+                 bench::keep(name);
+                 bench::keep(value);
+               }
+               sqlite3_finalize(stmt);
+             }});
+
+  int shape = 0;
+  suite.add({"converter round trip", 20000,
+             [&] {
+               exec(raw, "DELETE FROM Shapes");
+               shape = 0;
+             },
+             [&] {
+               insertInto(s).values(shape, Point{shape, -shape}).execute(db);
+               auto res = select(s.point).where(s.id == shape++).executeT(db);
+               bench::keep(res.get<0>());
+             },
+             [&] {
+               Point p{shape, -shape};
+               auto ins = prepare(raw, "INSERT INTO Shapes VALUES (?, ?)");
+               sqlite3_bind_int64(ins, 1, shape);
+               sqlite3_bind_blob(ins, 2, &p, sizeof(p), SQLITE_TRANSIENT);
+               sqlite3_step(ins);
+               sqlite3_finalize(ins);
+               auto sel = prepare(raw,
+                                  "SELECT Shapes.point FROM Shapes WHERE "
+                                  "Shapes.id = ?");
+               sqlite3_bind_int64(sel, 1, shape++);
+               Point out;
+               if (sqlite3_step(sel) == SQLITE_ROW &&
+                   sqlite3_column_bytes(sel, 0) == sizeof(Point))
+                 memcpy(&out, sqlite3_column_blob(sel, 0), sizeof(Point));
+               bench::keep(out);
+               sqlite3_finalize(sel);
+             }});
+
+  suite.run(std::cout);
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+}
@@ -0,0 +1,116 @@
+#include <sqlite3.h>
+#include <sqlpp.h>
+
+#include <filesystem>
+#include <map>
+#include <thread>
+
+#include "bench.h"
+
+using namespace sqlpp;
+
+struct Timings {
+  uint64_t count = 0;
+  std::chrono::nanoseconds captured{0};
+  std::chrono::nanoseconds replayed{0};
+  sketch::TDigest capturedDigest;
+  sketch::TDigest replayedDigest;
+};
+
+static void copyDatabase(const std::string& from, const std::string& to) {
+  Database source(from);
+  Database target(to);
+  auto backup =
+      sqlite3_backup_init(target.handle(), "main", source.handle(), "main");
+  if (!backup) throw std::runtime_error(sqlite3_errmsg(target.handle()));
+  sqlite3_backup_step(backup, -1);
+  if (sqlite3_backup_finish(backup) != SQLITE_OK)
+    throw std::runtime_error(sqlite3_errmsg(target.handle()));
+}
+
+static double us(double ns) { return ns / 1000.0; }
+
+int main(int argc, char* argv[]) try {
+  std::vector<std::string> args(argv + 1, argv + argc);
+  bool realtime = false;
+  std::erase_if(args, [&](const std::string& a) {
+    return a == "--realtime" && (realtime = true);
+  });
+  if (args.size() != 2) {
+    std::cerr << "Usage: " << argv[0] << " [--realtime] capture.log database"
+              << std::endl
+              << "Replays the captured statements against a copy of the "
+                 "database"
+              << std::endl;
+    return 2;
+  }
+
+  auto stamp = std::chrono::system_clock::now().time_since_epoch().count();
+  auto copy = std::filesystem::temp_directory_path() /
+              ("sqlpp_replay_" + std::to_string(stamp) + ".db");
+  copyDatabase(args[1], copy.string());
+
+  std::map<std::string, Timings> timings;
+  uint64_t mismatches = 0;
+  {
+    Database db(copy.string());
+    capture::Reader reader(args[0]);
+    capture::Statement s;
+    auto begin = std::chrono::steady_clock::now();
+    while (reader.next(s)) {
+      if (realtime) std::this_thread::sleep_until(begin + s.start);
+
+      std::vector<Bind> binds;
+      binds.reserve(s.binds.size());
+      for (const auto& v : s.binds) binds.push_back(capture::createBind(v));
+
+      // Timed like the capture: prepare, bind and the first step
+      auto start = std::chrono::steady_clock::now();
+      auto res = db.execute(s.sql, binds);
+      std::chrono::nanoseconds time = std::chrono::steady_clock::now() - start;
+      if (static_cast<bool>(res) != s.ok) ++mismatches;
+      while (res.hasData()) res.next();
+
+      auto& t = timings[s.fingerprint];
+      ++t.count;
+      t.captured += s.time;
+      t.replayed += time;
+      t.capturedDigest.add(s.time.count());
+      t.replayedDigest.add(time.count());
+    }
+  }
+  std::filesystem::remove(copy);
+
+  std::vector<std::pair<std::string, const Timings*>> rows;
+  for (const auto& [key, t] : timings) rows.emplace_back(key, &t);
+  std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+    return a.second->replayed > b.second->replayed;
+  });
+
+  std::chrono::nanoseconds captured{0};
+  std::chrono::nanoseconds replayed{0};
+  std::cout << std::setw(8) << "count" << std::setw(12) << "cap mean"
+            << std::setw(12) << "new mean" << std::setw(9) << "delta"
+            << std::setw(11) << "cap p99" << std::setw(11) << "new p99"
+            << "  statement (times in us)\n"
+            << std::fixed << std::setprecision(1);
+  for (const auto& [key, t] : rows) {
+    double capMean = us(t->captured.count()) / t->count;
+    double newMean = us(t->replayed.count()) / t->count;
+    std::cout << std::setw(8) << t->count << std::setw(12) << capMean
+              << std::setw(12) << newMean << std::setw(8)
+              << 100.0 * (newMean - capMean) / capMean << "%" << std::setw(11)
+              << us(t->capturedDigest.quantile(0.99)) << std::setw(11)
+              << us(t->replayedDigest.quantile(0.99)) << "  " << key << "\n";
+    captured += t->captured;
+    replayed += t->replayed;
+  }
+  std::cout << "total: captured " << us(captured.count()) << " us, replayed "
+            << us(replayed.count()) << " us, delta "
+            << 100.0 * (replayed - captured).count() / captured.count()
+            << "%, result mismatches " << mismatches << std::endl;
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+}
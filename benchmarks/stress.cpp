@@ -0,0 +1,357 @@
+#include <sqlite3.h>
+#include <sqlpp.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "bench.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Item final : public Table<Item, int, std::string, int> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0>;
+
+  Item() : Table("Items", {"id", "payload", "counter"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> payload = column<1>();
+  Column<2> counter = column<2>();
+};
+
+// Scenario file of "key = value" lines, "#" starts a comment
+struct Scenario {
+  std::string name;
+  std::string database;
+  int durationMs = 5000;
+  int rows = 10000;
+  int readers = 4;
+  int writers = 1;
+  int updaters = 0;
+  // Writes per BEGIN IMMEDIATE ... COMMIT transaction
+  int batch = 1;
+  // Every n-th read is a range scan of 100 rows, 0 for point reads only
+  int scanEvery = 0;
+  int payloadSize = 100;
+  int busyTimeoutMs = 0;
+  std::string synchronous = "NORMAL";
+  // WAL frames that trigger a checkpoint by the writing connection, 0 turns
+  // checkpoints off
+  int checkpointPages = 1000;
+  std::string checkpointMode = "PASSIVE";
+  uint64_t seed = 1;
+};
+
+static Scenario parse(const std::filesystem::path& path) {
+  std::ifstream file(path);
+  if (!file) throw std::runtime_error("Cannot open " + path.string());
+
+  std::map<std::string, std::string> values;
+  std::string line;
+  for (int n = 1; std::getline(file, line); ++n) {
+    line = line.substr(0, line.find('#'));
+    auto eq = line.find('=');
+    auto trim = [](std::string s) {
+      s.erase(0, s.find_first_not_of(" \t\r"));
+      s.erase(s.find_last_not_of(" \t\r") + 1);
+      return s;
+    };
+    if (trim(line).empty()) continue;
+    if (eq == std::string::npos)
+      throw std::runtime_error(path.string() + ":" + std::to_string(n) +
+                               ": expected key = value");
+    values[trim(line.substr(0, eq))] = trim(line.substr(eq + 1));
+  }
+
+  Scenario res;
+  res.name = path.stem().string();
+  auto take = [&](const char* key, auto& field) {
+    auto it = values.find(key);
+    if (it == values.end()) return;
+    std::istringstream ss(it->second);
+    ss >> field;
+    if (!ss) throw std::runtime_error("Invalid value of " + it->first);
+    values.erase(it);
+  };
+  take("name", res.name);
+  take("database", res.database);
+  take("duration_ms", res.durationMs);
+  take("rows", res.rows);
+  take("readers", res.readers);
+  take("writers", res.writers);
+  take("updaters", res.updaters);
+  take("batch", res.batch);
+  take("scan_every", res.scanEvery);
+  take("payload_size", res.payloadSize);
+  take("busy_timeout_ms", res.busyTimeoutMs);
+  take("synchronous", res.synchronous);
+  take("checkpoint_pages", res.checkpointPages);
+  take("checkpoint_mode", res.checkpointMode);
+  take("seed", res.seed);
+  if (!values.empty())
+    throw std::runtime_error("Unknown key " + values.begin()->first);
+  if (res.database.empty())
+    res.database =
+        (std::filesystem::temp_directory_path() / (res.name + ".db")).string();
+  return res;
+}
+
+enum Op { SELECT, SCAN, INSERT, UPDATE, OPS };
+
+static const char* OP_NAMES[] = {"select", "scan", "insert", "update"};
+
+struct Stats {
+  std::array<bench::Histogram, OPS> latency;
+  std::array<uint64_t, OPS> busy{};
+  bench::Histogram checkpoints;
+  uint64_t checkpointBusy = 0;
+
+  void merge(const Stats& other) {
+    for (size_t i = 0; i < OPS; ++i) {
+      latency[i].merge(other.latency[i]);
+      busy[i] += other.busy[i];
+    }
+    checkpoints.merge(other.checkpoints);
+    checkpointBusy += other.checkpointBusy;
+  }
+};
+
+struct Worker {
+  const Scenario& scenario;
+  Database db;
+  Stats stats;
+  // Error code of a rolled back transaction
+  int failure = SQLITE_OK;
+
+  Worker(const Scenario& scenario)
+      : scenario(scenario), db(scenario.database) {
+    sqlite3_busy_timeout(db.handle(), scenario.busyTimeoutMs);
+    db.execute("PRAGMA synchronous = " + scenario.synchronous);
+    // Checkpoints are run from the WAL hook below, so they can be timed
+    sqlite3_wal_autocheckpoint(db.handle(), 0);
+    if (scenario.checkpointPages > 0)
+      sqlite3_wal_hook(db.handle(), &Worker::walHook, this);
+  }
+
+  static int walHook(void* context, sqlite3* db, const char* name,
+                     int frames) {
+    auto worker = static_cast<Worker*>(context);
+    if (frames < worker->scenario.checkpointPages) return SQLITE_OK;
+    const auto& mode = worker->scenario.checkpointMode;
+    int kind = mode == "FULL"       ? SQLITE_CHECKPOINT_FULL
+               : mode == "RESTART"  ? SQLITE_CHECKPOINT_RESTART
+               : mode == "TRUNCATE" ? SQLITE_CHECKPOINT_TRUNCATE
+                                    : SQLITE_CHECKPOINT_PASSIVE;
+    auto start = std::chrono::steady_clock::now();
+    auto rc = sqlite3_wal_checkpoint_v2(db, name, kind, nullptr, nullptr);
+    worker->stats.checkpoints.add(std::chrono::steady_clock::now() - start);
+    if (rc == SQLITE_BUSY) ++worker->stats.checkpointBusy;
+    return SQLITE_OK;
+  }
+
+  // Runs the operation until it is not busy, only the successful run is
+  // timed
+  template <typename F>
+  void run(Op op, F&& f) {
+    for (;;) {
+      failure = SQLITE_OK;
+      auto start = std::chrono::steady_clock::now();
+      if (f()) {
+        stats.latency[op].add(std::chrono::steady_clock::now() - start);
+        return;
+      }
+      auto rc = failure != SQLITE_OK ? failure : sqlite3_errcode(db.handle());
+      if (rc != SQLITE_BUSY && rc != SQLITE_LOCKED)
+        throw std::runtime_error(sqlite3_errmsg(db.handle()));
+      ++stats.busy[op];
+      std::this_thread::yield();
+    }
+  }
+
+  // Wraps the writes in a transaction, a busy write rolls it back
+  template <typename F>
+  bool transaction(F&& write) {
+    if (!db.execute("BEGIN IMMEDIATE")) return false;
+    bool ok = true;
+    for (int i = 0; ok && i < scenario.batch; ++i) ok = write();
+    if (ok && db.execute("COMMIT")) return true;
+    failure = sqlite3_errcode(db.handle());
+    db.execute("ROLLBACK");
+    return false;
+  }
+};
+
+static void prepare(const Scenario& scenario) {
+  for (auto suffix : {"", "-wal", "-shm"})
+    std::filesystem::remove(scenario.database + suffix);
+
+  Database db(scenario.database);
+  db.execute("PRAGMA journal_mode = WAL");
+  Item it;
+  createTable(it).execute(db);
+  db.execute("BEGIN");
+  std::string payload(scenario.payloadSize, 'p');
+  for (int i = 0; i < scenario.rows; ++i)
+    insertInto(it).values(i, payload, 0).execute(db);
+  db.execute("COMMIT");
+  db.execute("PRAGMA wal_checkpoint(TRUNCATE)");
+}
+
+static void report(const Scenario& scenario, const Stats& stats,
+                   double seconds) {
+  int threads = scenario.readers + scenario.writers + scenario.updaters;
+  std::cout << "scenario " << scenario.name << ": " << scenario.readers
+            << " readers, " << scenario.writers << " writers, "
+            << scenario.updaters << " updaters, " << threads
+            << " threads, " << seconds << " s\n";
+  std::cout << std::left << std::setw(8) << "op" << std::right
+            << std::setw(10) << "count" << std::setw(11) << "ops/s"
+            << std::setw(9) << "busy" << std::setw(8) << "busy%"
+            << std::setw(9) << "mean us" << std::setw(9) << "p50 us"
+            << std::setw(9) << "p99 us" << std::setw(11) << "max us"
+            << "\n";
+  std::cout << std::fixed << std::setprecision(1);
+  for (size_t i = 0; i < OPS; ++i) {
+    const auto& h = stats.latency[i];
+    if (h.count() == 0 && stats.busy[i] == 0) continue;
+    double attempts = h.count() + stats.busy[i];
+    std::cout << std::left << std::setw(8) << OP_NAMES[i] << std::right
+              << std::setw(10) << h.count() << std::setw(11)
+              << h.count() / seconds << std::setw(9) << stats.busy[i]
+              << std::setw(8) << 100.0 * stats.busy[i] / attempts
+              << std::setw(9) << h.meanUs() << std::setw(9) << h.quantile(0.5)
+              << std::setw(9) << h.quantile(0.99) << std::setw(11)
+              << h.maxUs() << "\n";
+  }
+  const auto& cp = stats.checkpoints;
+  std::cout << "checkpoints: " << cp.count() << ", busy "
+            << stats.checkpointBusy << ", mean " << cp.meanUs()
+            << " us, p99 " << cp.quantile(0.99) << " us, max " << cp.maxUs()
+            << " us\n";
+  for (size_t i = 0; i < OPS; ++i) {
+    if (stats.latency[i].count() == 0) continue;
+    std::cout << "  " << OP_NAMES[i] << " latency\n";
+    stats.latency[i].print(std::cout);
+  }
+  if (cp.count() != 0) {
+    std::cout << "  checkpoint latency\n";
+    cp.print(std::cout);
+  }
+  std::cout << std::endl;
+}
+
+static void run(const Scenario& scenario) {
+  prepare(scenario);
+
+  std::atomic<bool> go = false;
+  std::atomic<bool> stop = false;
+  std::atomic<int> ready = 0;
+  std::mutex mutex;
+  Stats total;
+  std::exception_ptr error;
+
+  auto thread = [&](int index, int kind) {
+    try {
+      Worker w(scenario);
+      Item it;
+      std::mt19937_64 random(scenario.seed * 1000 + index);
+      std::uniform_int_distribution<int> key(0, scenario.rows - 1);
+      std::string payload(scenario.payloadSize, 'a' + index % 26);
+      int next = scenario.rows + index;
+      uint64_t reads = 0;
+
+      ++ready;
+      while (!go && !stop) std::this_thread::yield();
+      while (!stop) {
+        if (kind == SELECT) {
+          int k = key(random);
+          if (scenario.scanEvery > 0 && ++reads % scenario.scanEvery == 0) {
+            w.run(SCAN, [&] {
+              auto res = select(it.id, it.payload)
+                             .where(it.id >= k && it.id < k + 100)
+                             .executeT(w.db);
+              for (; res.hasData(); res.next()) bench::keep(res.get<1>());
+              return static_cast<bool>(res);
+            });
+          } else {
+            w.run(SELECT, [&] {
+              auto res = select(it.payload).where(it.id == k).executeT(w.db);
+              if (res.hasData()) bench::keep(res.get<0>());
+              return static_cast<bool>(res);
+            });
+          }
+        } else if (kind == INSERT) {
+          w.run(INSERT, [&] {
+            int first = next;
+            bool ok = w.transaction([&] {
+              bool res = insertInto(it).values(next, payload, 0).execute(w.db);
+              next += scenario.readers + scenario.writers + scenario.updaters;
+              return res;
+            });
+            if (!ok) next = first;
+            return ok;
+          });
+        } else {
+          w.run(UPDATE, [&] {
+            return w.transaction([&] {
+              return static_cast<bool>(
+                  update(it.counter = it.counter + 1)
+                      .where(it.id == key(random))
+                      .execute(w.db));
+            });
+          });
+        }
+      }
+
+      std::lock_guard lock(mutex);
+      total.merge(w.stats);
+    } catch (...) {
+      std::lock_guard lock(mutex);
+      if (!error) error = std::current_exception();
+      stop = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  int index = 0;
+  for (int i = 0; i < scenario.writers; ++i)
+    threads.emplace_back(thread, index++, INSERT);
+  for (int i = 0; i < scenario.updaters; ++i)
+    threads.emplace_back(thread, index++, UPDATE);
+  for (int i = 0; i < scenario.readers; ++i)
+    threads.emplace_back(thread, index++, SELECT);
+
+  while (ready < index && !stop) std::this_thread::yield();
+  go = true;
+  auto start = std::chrono::steady_clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(scenario.durationMs));
+  stop = true;
+  for (auto& t : threads) t.join();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  if (error) std::rethrow_exception(error);
+  report(scenario, total, elapsed.count());
+
+  for (auto suffix : {"", "-wal", "-shm"})
+    std::filesystem::remove(scenario.database + suffix);
+}
+
+int main(int argc, char* argv[]) try {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " scenario.scn..." << std::endl;
+    return 2;
+  }
+  for (int i = 1; i < argc; ++i) run(parse(argv[i]));
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+}
@@ -1,8 +1,13 @@
 #ifndef SQLPP_H_
 #define SQLPP_H_
 
+#include "sqlpp/capture.h"
 #include "sqlpp/database.h"
+#include "sqlpp/function.h"
+#include "sqlpp/profiler.h"
+#include "sqlpp/sketch.h"
 #include "sqlpp/statement.h"
 #include "sqlpp/table.h"
+#include "sqlpp/timing.h"
 
 #endif /* SQLPP_H_ */
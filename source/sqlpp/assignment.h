@@ -8,12 +8,15 @@ namespace sqlpp {
 template <typename T, typename V, size_t I>
 class Column;
 
-template <typename T, typename V, size_t I>
+// E lists the tables the assigned expression refers to, it may contain tables
+// other than T in UPDATE ... FROM
+template <typename T, typename V, size_t I, typename E = types::MakeSet<T>>
 class Assignment {
  public:
   using Table = T;
+  using Tables = E;
   static constexpr size_t INDEX = I;
-  using Expression = expr::Expression<types::MakeSet<T>, DbType<V>>;
+  using Expression = expr::Expression<E, DbType<V>>;
 
   Assignment(const Column<T, V, I>& column, const Expression& expression)
       : column(column), expression(expression) {}
@@ -0,0 +1,212 @@
+#include "capture.h"
+
+#include <bit>
+#include <stdexcept>
+
+#include "profiler.h"
+
+namespace sqlpp::capture {
+
+static thread_local std::vector<Value>* recording = nullptr;
+
+Recorder::Recorder(std::vector<Value>& values) : previous(recording) {
+  recording = &values;
+}
+
+Recorder::~Recorder() { recording = previous; }
+
+bool Recorder::active() { return recording != nullptr; }
+
+void Recorder::record(Value&& value) {
+  if (recording) recording->push_back(std::move(value));
+}
+
+static constexpr char MAGIC[] = "SQLPPCAP";
+static constexpr size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+static constexpr char VERSION = 1;
+
+enum Tag : char {
+  DEFINE = 'S',
+  EXECUTE = 'E',
+};
+
+enum ValueTag : char {
+  INTEGER,
+  REAL,
+  TEXT,
+  BLOB,
+};
+
+static void putVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out += static_cast<char>(value | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+static void putBytes(std::string& out, const void* data, size_t size) {
+  putVarint(out, size);
+  out.append(static_cast<const char*>(data), size);
+}
+
+static void putValue(std::string& out, const Value& value) {
+  if (auto i = std::get_if<Integer>(&value)) {
+    out += INTEGER;
+    auto u = static_cast<uint64_t>(*i);
+    putVarint(out, (u << 1) ^ (*i < 0 ? ~uint64_t(0) : 0));
+  } else if (auto r = std::get_if<Real>(&value)) {
+    out += REAL;
+    auto bits = std::bit_cast<uint64_t>(*r);
+    for (int i = 0; i < 8; ++i) out += static_cast<char>(bits >> (8 * i));
+  } else if (auto t = std::get_if<Text>(&value)) {
+    out += TEXT;
+    putBytes(out, t->data(), t->size());
+  } else {
+    const auto& b = std::get<Blob>(value);
+    out += BLOB;
+    putBytes(out, b.data(), b.size());
+  }
+}
+
+Writer::Writer(const std::string& path)
+    : file(path, std::ios::binary | std::ios::trunc),
+      begin(std::chrono::steady_clock::now()) {
+  if (!file) throw std::runtime_error("Cannot create capture file " + path);
+  file.write(MAGIC, MAGIC_SIZE);
+  file.put(VERSION);
+}
+
+Writer::~Writer() { flush(); }
+
+void Writer::write(const std::string& sql, const std::vector<Value>& binds,
+                   std::chrono::steady_clock::time_point start,
+                   std::chrono::nanoseconds time, bool ok) {
+  std::lock_guard lock(mutex);
+  auto [it, added] = ids.try_emplace(sql, ids.size());
+  if (added) {
+    buffer += DEFINE;
+    putVarint(buffer, it->second);
+    auto key = fingerprint(sql);
+    putBytes(buffer, key.data(), key.size());
+    putBytes(buffer, sql.data(), sql.size());
+  }
+
+  // Starts are stored as the delta to the previous one, threads may race
+  // a little, so they are kept monotonic
+  auto since =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(start - begin);
+  auto offset = std::max(last, since);
+  buffer += EXECUTE;
+  putVarint(buffer, it->second);
+  putVarint(buffer, (offset - last).count());
+  putVarint(buffer, std::max<int64_t>(time.count(), 0));
+  buffer += static_cast<char>(ok);
+  putVarint(buffer, binds.size());
+  for (const auto& v : binds) putValue(buffer, v);
+  last = offset;
+
+  if (buffer.size() >= 64 * 1024) {
+    file.write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+}
+
+void Writer::flush() {
+  std::lock_guard lock(mutex);
+  file.write(buffer.data(), buffer.size());
+  buffer.clear();
+  file.flush();
+}
+
+Reader::Reader(const std::string& path) : file(path, std::ios::binary) {
+  char header[MAGIC_SIZE + 1];
+  if (!file.read(header, sizeof(header)) ||
+      std::string(header, MAGIC_SIZE) != MAGIC)
+    throw std::runtime_error("Not a capture file " + path);
+  if (header[MAGIC_SIZE] != VERSION)
+    throw std::runtime_error("Unsupported capture version in " + path);
+}
+
+static char getByte(std::ifstream& file) {
+  char c;
+  if (!file.get(c)) throw std::runtime_error("Truncated capture file");
+  return c;
+}
+
+static uint64_t getVarint(std::ifstream& file) {
+  uint64_t res = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    auto byte = static_cast<unsigned char>(getByte(file));
+    res |= uint64_t(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) return res;
+  }
+  throw std::runtime_error("Invalid varint in capture file");
+}
+
+static std::string getBytes(std::ifstream& file) {
+  std::string res(getVarint(file), '\0');
+  if (!file.read(res.data(), res.size()))
+    throw std::runtime_error("Truncated capture file");
+  return res;
+}
+
+static Value getValue(std::ifstream& file) {
+  switch (getByte(file)) {
+    case INTEGER: {
+      auto u = getVarint(file);
+      return static_cast<Integer>((u >> 1) ^ (~(u & 1) + 1));
+    }
+    case REAL: {
+      uint64_t bits = 0;
+      for (int i = 0; i < 8; ++i)
+        bits |= uint64_t(static_cast<unsigned char>(getByte(file)))
+                << (8 * i);
+      return std::bit_cast<Real>(bits);
+    }
+    case TEXT:
+      return getBytes(file);
+    case BLOB: {
+      auto bytes = getBytes(file);
+      auto ptr = reinterpret_cast<const std::byte*>(bytes.data());
+      return Blob(ptr, ptr + bytes.size());
+    }
+  }
+  throw std::runtime_error("Invalid value in capture file");
+}
+
+bool Reader::next(Statement& statement) {
+  for (;;) {
+    char tag;
+    if (!file.get(tag)) return false;
+    if (tag == DEFINE) {
+      auto id = getVarint(file);
+      if (id != statements.size())
+        throw std::runtime_error("Invalid statement id in capture file");
+      auto key = getBytes(file);
+      statements.emplace_back(std::move(key), getBytes(file));
+    } else if (tag == EXECUTE) {
+      auto id = getVarint(file);
+      if (id >= statements.size())
+        throw std::runtime_error("Unknown statement id in capture file");
+      statement.fingerprint = statements[id].first;
+      statement.sql = statements[id].second;
+      last += std::chrono::nanoseconds(getVarint(file));
+      statement.start = last;
+      statement.time = std::chrono::nanoseconds(getVarint(file));
+      statement.ok = getByte(file) != 0;
+      statement.binds.resize(getVarint(file));
+      for (auto& v : statement.binds) v = getValue(file);
+      return true;
+    } else {
+      throw std::runtime_error("Invalid record in capture file");
+    }
+  }
+}
+
+Bind createBind(const Value& value) {
+  return std::visit([](const auto& v) -> Bind { return sqlpp::createBind(v); },
+                    value);
+}
+
+}  // namespace sqlpp::capture
@@ -0,0 +1,93 @@
+#ifndef SQLPP_CAPTURE_H_
+#define SQLPP_CAPTURE_H_
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "types.h"
+
+namespace sqlpp::capture {
+
+using Value = std::variant<Integer, Real, Text, Blob>;
+
+struct Statement {
+  std::string fingerprint;
+  std::string sql;
+  std::vector<Value> binds;
+  // Since the start of the capture
+  std::chrono::nanoseconds start{0};
+  // Prepare, bind and the first step of Database::execute
+  std::chrono::nanoseconds time{0};
+  bool ok = true;
+};
+
+// The values passed to bind() on this thread are appended to the vector
+// while the recorder lives
+class Recorder {
+ public:
+  explicit Recorder(std::vector<Value>& values);
+  Recorder(const Recorder&) = delete;
+  ~Recorder();
+
+  Recorder& operator=(const Recorder&) = delete;
+
+  // Checked by bind() before copying the value for record()
+  static bool active();
+  static void record(Value&& value);
+
+ private:
+  std::vector<Value>* previous;
+};
+
+// Workload log: "SQLPPCAP" and a version byte, then records. A 'S' record
+// defines the fingerprint and SQL of a statement id once, an 'E' record is
+// an execution of the id with the start delta, time, result and binds.
+// Integers are zigzag varints, reals are 8 little endian bytes.
+class Writer {
+ public:
+  explicit Writer(const std::string& path);
+  Writer(const Writer&) = delete;
+  ~Writer();
+
+  Writer& operator=(const Writer&) = delete;
+
+  std::chrono::steady_clock::time_point startTime() const { return begin; }
+
+  void write(const std::string& sql, const std::vector<Value>& binds,
+             std::chrono::steady_clock::time_point start,
+             std::chrono::nanoseconds time, bool ok);
+  void flush();
+
+ private:
+  std::mutex mutex;
+  std::ofstream file;
+  std::string buffer;
+  std::unordered_map<std::string, uint64_t> ids;
+  std::chrono::steady_clock::time_point begin;
+  std::chrono::nanoseconds last{0};
+};
+
+class Reader {
+ public:
+  explicit Reader(const std::string& path);
+
+  // False at the end of the log, throws on a corrupted log
+  bool next(Statement& statement);
+
+ private:
+  std::ifstream file;
+  std::vector<std::pair<std::string, std::string>> statements;
+  std::chrono::nanoseconds last{0};
+};
+
+// Bind for a captured value, used to replay the statement
+Bind createBind(const Value& value);
+
+}  // namespace sqlpp::capture
+
+#endif /* SQLPP_CAPTURE_H_ */
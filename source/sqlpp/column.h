@@ -4,7 +4,7 @@
 #include <string>
 
 #include "assignment.h"
-#include "expr/expression.h"
+#include "expr/condition.h"
 #include "types.h"
 #include "value.h"
 
@@ -33,7 +33,30 @@ class Column : public expr::Expression<types::MakeSet<T>, DbType<V>> {
       std::enable_if_t<
           std::is_same_v<expr::ExprTerm<expr::AnyExpr, E>, DbType<V>>, int> = 0>
   auto operator=(E&& expression) const {
-    return Assignment<T, V, I>(*this, std::forward<E>(expression));
+    return Assignment<T, V, I, expr::ExprTables<expr::AnyExpr, E>>(
+        *this, std::forward<E>(expression));
+  }
+
+  template <std::ranges::input_range R>
+  expr::Condition<types::MakeSet<T>> in(const R& values) const {
+    static_assert(
+        std::is_same_v<DbType<std::ranges::range_value_t<R>>, DbType<V>>,
+        "Set value type does not match to column's one");
+    return expr::Condition<types::MakeSet<T>>(
+        expr::BinaryOperator::Op::IN, *this,
+        expr::ValueSet<DbType<V>>(values));
+  }
+
+  template <typename S, typename = typename S::Values>
+  expr::Condition<types::MakeSet<T>> in(const S& select) const {
+    using Values = typename S::Values;
+    static_assert(types::Size<Values> == 1,
+                  "Subquery must return exactly one column");
+    static_assert(std::is_same_v<DbType<types::Head<Values>>, DbType<V>>,
+                  "Subquery value type does not match to column's one");
+    return expr::Condition<types::MakeSet<T>>(
+        expr::BinaryOperator::Op::IN, *this,
+        expr::SubqueryExpr<types::List<>, DbType<V>>(select));
   }
 
  protected:
@@ -2,8 +2,13 @@
 
 #include <sqlite3.h>
 
+#include <optional>
 #include <stdexcept>
 
+#include "capture.h"
+#include "profiler.h"
+#include "timing.h"
+
 namespace sqlpp {
 
 Database::Database(const std::string& filename) {
@@ -15,27 +20,46 @@ Database::Database(const std::string& filename) {
   }
 }
 
-Database::Database(Database&& other) { std::swap(db, other.db); }
+Database::Database(Database&& other) {
+  std::swap(db, other.db);
+  std::swap(profiling, other.profiling);
+  std::swap(capturing, other.capturing);
+}
 
 Database::~Database() {
-  if (db) sqlite3_close(db);
+  if (db) {
+    if (profiling) sqlite3_trace_v2(db, 0, nullptr, nullptr);
+    sqlite3_close(db);
+  }
 }
 
 Database& Database::operator=(Database&& other) {
   if (this != &other) {
     std::swap(db, other.db);
+    std::swap(profiling, other.profiling);
+    std::swap(capturing, other.capturing);
     if (other.db) {
+      if (other.profiling) sqlite3_trace_v2(other.db, 0, nullptr, nullptr);
       sqlite3_close(other.db);
       other.db = nullptr;
     }
+    other.profiling.reset();
+    other.capturing.reset();
   }
   return *this;
 }
 
 Result Database::execute(const std::string& sql,
                          const std::vector<Bind>& values) const {
+  std::chrono::steady_clock::time_point start;
+  if (capturing) start = std::chrono::steady_clock::now();
+
   sqlite3_stmt* stmt = nullptr;
-  auto rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
+  int rc;
+  {
+    SQLPP_TIME(PREPARE);
+    rc = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
+  }
   if (rc != SQLITE_OK) {
     std::string err(sqlite3_errmsg(db));
     throw std::runtime_error("SQLite error in statement \"" + sql +
@@ -44,12 +68,116 @@ Result Database::execute(const std::string& sql,
 
   Result res(stmt);
 
-  int i = 1;
-  for (auto&& v : values) v(res.handle(), i++);
+  std::vector<capture::Value> captured;
+  {
+    SQLPP_TIME(BIND);
+    std::optional<capture::Recorder> recorder;
+    if (capturing) recorder.emplace(captured);
+    int i = 1;
+    for (auto&& v : values) v(res.handle(), i++);
+  }
 
   res.next();
 
+  if (capturing)
+    capturing->write(sql, captured, start,
+                     std::chrono::steady_clock::now() - start, res);
+
+  return res;
+}
+
+Profiler& Database::startProfiling(std::chrono::nanoseconds slowThreshold,
+                                   size_t slowLogSize) {
+  auto next = std::make_unique<Profiler>(slowThreshold, slowLogSize);
+  sqlite3_trace_v2(
+      db, SQLITE_TRACE_STMT | SQLITE_TRACE_ROW | SQLITE_TRACE_PROFILE,
+      Profiler::trace, next.get());
+  profiling = std::move(next);
+  return *profiling;
+}
+
+// Lookaside hit and miss counts are reported as the high-water value
+enum class Report { Current, Highwater, Both };
+
+struct Counter {
+  int op;
+  const char* name;
+  Report report;
+};
+
+static const Counter CONNECTION_COUNTERS[] = {
+    {SQLITE_DBSTATUS_CACHE_HIT, "cache.hit", Report::Current},
+    {SQLITE_DBSTATUS_CACHE_MISS, "cache.miss", Report::Current},
+    {SQLITE_DBSTATUS_CACHE_WRITE, "cache.write", Report::Current},
+    {SQLITE_DBSTATUS_CACHE_SPILL, "cache.spill", Report::Current},
+    {SQLITE_DBSTATUS_CACHE_USED, "cache.used", Report::Current},
+    {SQLITE_DBSTATUS_CACHE_USED_SHARED, "cache.used_shared", Report::Current},
+    {SQLITE_DBSTATUS_LOOKASIDE_USED, "lookaside.used", Report::Both},
+    {SQLITE_DBSTATUS_LOOKASIDE_HIT, "lookaside.hit", Report::Highwater},
+    {SQLITE_DBSTATUS_LOOKASIDE_MISS_SIZE, "lookaside.miss_size",
+     Report::Highwater},
+    {SQLITE_DBSTATUS_LOOKASIDE_MISS_FULL, "lookaside.miss_full",
+     Report::Highwater},
+    {SQLITE_DBSTATUS_SCHEMA_USED, "schema.used", Report::Current},
+    {SQLITE_DBSTATUS_STMT_USED, "stmt.used", Report::Current},
+};
+
+static const Counter PROCESS_COUNTERS[] = {
+    {SQLITE_STATUS_MEMORY_USED, "process.memory_used", Report::Both},
+    {SQLITE_STATUS_MALLOC_COUNT, "process.malloc_count", Report::Both},
+    {SQLITE_STATUS_MALLOC_SIZE, "process.malloc_size", Report::Highwater},
+    {SQLITE_STATUS_PAGECACHE_USED, "process.pagecache_used", Report::Both},
+    {SQLITE_STATUS_PAGECACHE_OVERFLOW, "process.pagecache_overflow",
+     Report::Both},
+    {SQLITE_STATUS_PAGECACHE_SIZE, "process.pagecache_size",
+     Report::Highwater},
+};
+
+static void addMetric(std::map<std::string, int64_t>& metrics,
+                      const Counter& counter, int64_t current,
+                      int64_t highwater) {
+  if (counter.report == Report::Highwater)
+    metrics[counter.name] = highwater;
+  else
+    metrics[counter.name] = current;
+  if (counter.report == Report::Both)
+    metrics[std::string(counter.name) + ".highwater"] = highwater;
+}
+
+std::map<std::string, int64_t> Database::metrics(bool reset) const {
+  std::map<std::string, int64_t> res;
+  for (const auto& c : CONNECTION_COUNTERS) {
+    int current = 0;
+    int highwater = 0;
+    if (sqlite3_db_status(db, c.op, &current, &highwater, reset) == SQLITE_OK)
+      addMetric(res, c, current, highwater);
+  }
+  for (const auto& c : PROCESS_COUNTERS) {
+    sqlite3_int64 current = 0;
+    sqlite3_int64 highwater = 0;
+    if (sqlite3_status64(c.op, &current, &highwater, false) == SQLITE_OK)
+      addMetric(res, c, current, highwater);
+  }
   return res;
 }
 
+void Database::resetProcessMetrics() {
+  for (const auto& c : PROCESS_COUNTERS) {
+    sqlite3_int64 current = 0;
+    sqlite3_int64 highwater = 0;
+    sqlite3_status64(c.op, &current, &highwater, true);
+  }
+}
+
+void Database::startCapture(const std::string& path) {
+  capturing = std::make_unique<capture::Writer>(path);
+}
+
+void Database::stopCapture() { capturing.reset(); }
+
+void Database::stopProfiling() {
+  sqlite3_trace_v2(db, 0, nullptr, nullptr);
+  profiling.reset();
+}
+
 }  // namespace sqlpp
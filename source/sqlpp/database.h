@@ -1,15 +1,27 @@
 #ifndef SQLPP_DATABASE_H_
 #define SQLPP_DATABASE_H_
 
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
 #include <string>
 
 #include "result.h"
 #include "types.h"
 
 struct sqlite3;
+struct sqlite3_context;
+struct sqlite3_value;
 
 namespace sqlpp {
 
+class Profiler;
+
+namespace capture {
+class Writer;
+}
+
 class Database {
  public:
   explicit Database(const std::string& filename);
@@ -26,8 +38,57 @@ class Database {
   Result execute(const std::string& sql,
                  const std::vector<Bind>& values = {}) const;
 
+  // Registers a C++ callable as an SQL function, its argument and result types
+  // must have a Converter. Returns a UserFunction to call it in statements.
+  // Pure functions may pass deterministic so SQLite can factor out their calls
+  // and accept them in indexes. Defined in function.h
+  template <typename F>
+  auto registerFunction(const std::string& name, F&& function,
+                        bool deterministic = false) const;
+
+  // Registers an aggregate with the state S, step(S&, args...) is called for
+  // every row and final(const S&) gives the result. Defined in function.h
+  template <typename S, typename F, typename G>
+  auto registerAggregate(const std::string& name, F&& step, G&& final,
+                         bool deterministic = false) const;
+
+  // Starts tracing the statement timings into a new profiler, statements
+  // slower than the threshold are kept in its slow query log. Nothing is
+  // traced until profiling is started.
+  Profiler& startProfiling(
+      std::chrono::nanoseconds slowThreshold = std::chrono::milliseconds(100),
+      size_t slowLogSize = 64);
+  void stopProfiling();
+  // The current profiler or nullptr
+  const Profiler* profiler() const { return profiling.get(); }
+
+  // Connection counters of sqlite3_db_status ("cache.hit", "lookaside.used",
+  // "schema.used", ...) and process wide allocator counters of
+  // sqlite3_status64 ("process.memory_used", ...), high-water marks end with
+  // ".highwater". Reset clears the hit/miss counters and the high-water marks
+  // of this connection after reading them, the process counters are shared by
+  // every connection and left alone.
+  std::map<std::string, int64_t> metrics(bool reset = false) const;
+  // Resets the process wide high-water marks of sqlite3_status64
+  static void resetProcessMetrics();
+
+  // Appends every statement run by execute() with its bind values and time
+  // to a workload log at the path, see capture.h and benchmarks/replay
+  void startCapture(const std::string& path);
+  void stopCapture();
+
  private:
+  using FunctionCallback = void (*)(sqlite3_context*, int, sqlite3_value**);
+  using FinalCallback = void (*)(sqlite3_context*);
+
+  void createFunction(const std::string& name, int argCount,
+                      bool deterministic, void* data, FunctionCallback function,
+                      FunctionCallback step, FinalCallback final,
+                      void (*destroy)(void*)) const;
+
   sqlite3* db = nullptr;
+  std::unique_ptr<Profiler> profiling;
+  std::unique_ptr<capture::Writer> capturing;
 };
 
 }  // namespace sqlpp
@@ -0,0 +1,98 @@
+#ifndef SRC_SQLPP_EXPR_AGGREGATE_H_
+#define SRC_SQLPP_EXPR_AGGREGATE_H_
+
+#include "../table.h"
+#include "condition.h"
+#include "window.h"
+
+namespace sqlpp {
+
+namespace expr {
+
+template <typename... E>
+struct AvgExpr;
+
+template <typename V, typename... T>
+struct AvgExpr<Expression<T, V>...> {
+  using Tables = typename NumExpr<Expression<T, V>...>::Tables;
+  using Term = Real;
+};
+
+template <typename... E>
+struct CountExpr;
+
+template <typename V, typename... T>
+struct CountExpr<Expression<T, V>...> {
+  using Tables = types::Merge<T...>;
+  using Term = Integer;
+};
+
+class AllColumns : public Expression<types::List<>, Integer> {
+ public:
+  AllColumns()
+      : Expression<types::List<>, Integer>(
+            Data(Node::make<Leaf>("*"), std::vector<Bind>())) {}
+};
+
+// The * of the table B, it puts the table into FROM
+template <typename B>
+class AllRows : public Expression<types::List<B>, Integer> {
+ public:
+  explicit AllRows(const std::string& table)
+      : Expression<types::List<B>, Integer>(
+            Data(Node::make<Leaf>("*"), table)) {}
+};
+
+}  // namespace expr
+
+inline expr::Aggregate<types::List<>, Integer> count() {
+  return expr::Aggregate<types::List<>, Integer>("count", false,
+                                                 expr::AllColumns());
+}
+
+// Rows of the table, e.g. select(count(t)) counts all rows of t
+template <typename B, typename... U>
+expr::Aggregate<types::List<B>, Integer> count(const Table<B, U...>& table) {
+  return expr::Aggregate<types::List<B>, Integer>(
+      "count", false, expr::AllRows<B>(table.getName()));
+}
+
+template <expr::IsExpression E>
+expr::AggregateResult<expr::CountExpr, E> count(E&& e) {
+  return expr::AggregateResult<expr::CountExpr, E>("count", false,
+                                                   std::forward<E>(e));
+}
+
+template <typename E>
+expr::AggregateResult<expr::CountExpr, E> countDistinct(E&& e) {
+  return expr::AggregateResult<expr::CountExpr, E>("count", true,
+                                                   std::forward<E>(e));
+}
+
+template <typename E>
+expr::AggregateResult<expr::NumExpr, E> sum(E&& e) {
+  return expr::AggregateResult<expr::NumExpr, E>("sum", false,
+                                                 std::forward<E>(e));
+}
+
+template <typename E>
+expr::AggregateResult<expr::AvgExpr, E> avg(E&& e) {
+  return expr::AggregateResult<expr::AvgExpr, E>("avg", false,
+                                                 std::forward<E>(e));
+}
+
+template <typename E>
+expr::AggregateResult<expr::AnyExpr, E> min(E&& e) {
+  return expr::AggregateResult<expr::AnyExpr, E>("min", false,
+                                                 std::forward<E>(e));
+}
+
+template <typename E>
+expr::AggregateResult<expr::AnyExpr, E> max(E&& e) {
+  return expr::AggregateResult<expr::AnyExpr, E>("max", false,
+                                                 std::forward<E>(e));
+}
+
+}  // namespace sqlpp
+
+#endif /* SRC_SQLPP_EXPR_AGGREGATE_H_ */
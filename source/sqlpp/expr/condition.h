@@ -7,15 +7,18 @@ namespace sqlpp {
 
 namespace stmt {
 
-template <typename T, typename V>
+template <typename T, typename V, typename J>
 class Select;
 
-template <typename T, typename V, typename C>
-class SelectWher;
+template <typename T, typename V, typename J, typename B>
+class SelectJoin;
 
-template <typename T, typename C>
+template <typename T, typename U, typename F>
 class UpdateWhere;
 
+template <typename T, typename C>
+class DeleteWhere;
+
 }  // namespace stmt
 
 namespace expr {
@@ -25,14 +28,17 @@ class Condition : public Expression<T, bool> {
   template <typename A>
   friend class Condition;
 
-  template <typename A, typename B>
+  template <typename A, typename B, typename C>
   friend class stmt::Select;
 
+  template <typename A, typename B, typename C, typename D>
+  friend class stmt::SelectJoin;
+
   template <typename A, typename B, typename C>
-  friend class stmt::SelectWher;
+  friend class stmt::UpdateWhere;
 
   template <typename A, typename B>
-  friend class stmt::UpdateWhere;
+  friend class stmt::DeleteWhere;
 
  public:
   using Expression<T, bool>::Expression;
@@ -1,43 +1,88 @@
 #ifndef SRC_SQLPP_EXPR_EXPRESSION_H_
 #define SRC_SQLPP_EXPR_EXPRESSION_H_
 
+#include <ranges>
+
 #include "node.h"
 
 namespace sqlpp {
 
 namespace stmt {
 
-template <typename T, typename V>
+template <typename T, typename V, typename J>
 class SelectWhere;
 
-template <typename T, typename V>
+template <typename T, typename V, typename J>
 class SelectGroupBy;
 
-template <typename T>
+template <typename T, typename V, typename J>
+class Select;
+
+template <typename T, typename U, typename F>
 class Update;
 
+template <typename D, typename T>
+class ReturningStatement;
+
+template <typename T>
+class UpsertUpdate;
+
 }  // namespace stmt
 
 namespace expr {
 
+template <typename T>
+class Window;
+
+template <typename T, typename V>
+class WindowFunction;
+
+template <typename T, typename V>
+class CaseExpr;
+
+template <typename T>
+class OrderTerm;
+
 template <typename T, typename V>
 class Expression {
   template <typename A, typename B>
   friend class Expression;
 
+  template <typename A>
+  friend class OrderTerm;
+
+  template <typename A>
+  friend class Window;
+
   template <typename A, typename B>
-  friend class stmt::SelectWhere;
+  friend class WindowFunction;
 
   template <typename A, typename B>
+  friend class CaseExpr;
+
+  template <typename A, typename B, typename C>
+  friend class stmt::SelectWhere;
+
+  template <typename A, typename B, typename C>
   friend class stmt::SelectGroupBy;
 
-  template <typename A>
+  template <typename A, typename B, typename C>
+  friend class stmt::Select;
+
+  template <typename A, typename B, typename C>
   friend class stmt::Update;
 
+  template <typename A, typename B>
+  friend class stmt::ReturningStatement;
+
+  template <typename A>
+  friend class stmt::UpsertUpdate;
+
  protected:
   Expression(const std::string& table, const std::string& field)
       : data(table, field) {}
   explicit Expression(Bind&& bind) : data(std::move(bind)) {}
+  explicit Expression(Data&& data) : data(std::move(data)) {}
 
  public:
   using ExpressionType = Expression<T, V>;
@@ -49,6 +94,10 @@ class Expression {
   Expression(BinaryOperator::Op op, E1&& e1, E2&& e2)
       : data(op, std::forward<E1>(e1).data, std::forward<E2>(e2).data) {}
 
+  template <typename... E>
+  Expression(const std::string& function, bool distinct, E&&... args)
+      : data(function, distinct, makeArgs(std::forward<E>(args)...)) {}
+
   Expression(const Expression&) = default;
   Expression(Expression&&) = default;
 
@@ -59,6 +108,15 @@ class Expression {
 
  protected:
   Data data;
+
+ private:
+  template <typename... E>
+  static std::vector<Data> makeArgs(E&&... args) {
+    std::vector<Data> res;
+    res.reserve(sizeof...(E));
+    (res.push_back(std::forward<E>(args).data), ...);
+    return res;
+  }
 };
 
 template <typename V>
@@ -68,6 +126,55 @@ class Literal : public Expression<types::List<>, V> {
   Literal(const U& value) : Expression<types::List<>, V>(createBind(value)) {}
 };
 
+// Whole set of values bound as a single JSON array parameter and expanded by
+// json_each(), so the statement text does not depend on the set size
+template <typename V>
+class ValueSet : public Expression<types::List<>, V> {
+  static_assert(!std::is_same_v<V, Blob>, "BLOB value set is not supported");
+
+ public:
+  template <std::ranges::input_range R>
+  explicit ValueSet(const R& range)
+      : Expression<types::List<>, V>(makeData(range)) {}
+
+ private:
+  template <typename R>
+  static Data makeData(const R& range) {
+    std::string json = "[";
+    for (auto&& v : range) {
+      if (json.size() > 1) json += ",";
+      appendJson(json, toDb(v));
+    }
+    json += "]";
+    std::vector<Bind> binds;
+    binds.emplace_back(createBind(std::move(json)));
+    return Data(Node::make<Subquery>("SELECT value FROM json_each(?)"),
+                std::move(binds));
+  }
+};
+
+template <typename T, typename V>
+class SubqueryExpr : public Expression<T, V> {
+ public:
+  template <typename S, typename... O>
+  explicit SubqueryExpr(const S& select, const O&... outer)
+      : Expression<T, V>(select.subquery(outer...)) {}
+};
+
+// Column of the 'excluded' pseudo-table of an upsert; it is typed as a column
+// of the inserted table, though it does not make the table referenced
+template <typename T, typename V>
+class Excluded : public Expression<T, V> {
+ public:
+  explicit Excluded(const std::string& column)
+      : Expression<T, V>(Data(Node::make<Leaf>("excluded", column),
+                              std::vector<Bind>())) {}
+};
+
+template <typename E>
+concept IsExpression =
+    requires { typename std::remove_cvref_t<E>::ExpressionType; };
+
 template <template <typename...> typename S, typename... E>
 using ExprTables =
     typename S<typename std::remove_cvref_t<E>::ExpressionType...>::Tables;
@@ -137,6 +244,41 @@ struct AllExpr<Expression<T, V>> {
   using Tables = T;
 };
 
+// Sort key with a direction, made by asc() and desc(). It is not an
+// expression, so it can be given only to orderBy().
+template <typename T>
+class OrderTerm {
+  template <typename A>
+  friend class Window;
+
+  template <typename A, typename B, typename C>
+  friend class stmt::SelectGroupBy;
+
+ public:
+  using Tables = T;
+
+  template <typename E>
+  OrderTerm(Order order, E&& e) : data(order, std::forward<E>(e).data) {}
+
+ private:
+  Data data;
+};
+
+template <typename E>
+struct OrderKey {
+  using Tables = ExprTables<AnyExpr, E>;
+};
+
+template <typename T>
+struct OrderKey<OrderTerm<T>> {
+  using Tables = T;
+};
+
+// Tables of the orderBy() arguments, which are expressions or sort keys
+template <typename... E>
+using OrderTables = types::Merge<
+    types::List<>, typename OrderKey<std::remove_cvref_t<E>>::Tables...>;
+
 template <typename E>
 ExprResult<NumExpr, E> operator-(E&& e) {
   return ExprResult<NumExpr, E>(UnaryOperator::Op::MINUS, std::forward<E>(e));
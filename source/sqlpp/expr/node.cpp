@@ -23,6 +23,8 @@ Node::~Node() = default;
 
 Leaf::Leaf() : value("?") {}
 
+Leaf::Leaf(const std::string& value) : value(value) {}
+
 Leaf::Leaf(const std::string& table, const std::string& field)
     : value(table + "." + field) {}
 
@@ -54,7 +56,8 @@ int UnaryOperator::getPrecedence() const {
 }
 
 void UnaryOperator::dump(std::ostream& stream, bool parenthesis) const {
-  static const std::vector<std::string> OpStr = {"-", "+", "~", "NOT "};
+  static const std::vector<std::string> OpStr = {"-", "+", "~", "NOT ",
+                                                 "EXISTS "};
 
   if (parenthesis) stream << "(";
   stream << OpStr[static_cast<int>(op)];
@@ -103,6 +106,7 @@ int BinaryOperator::getPrecedence() const {
 
     case Op::EQ:
     case Op::NE:
+    case Op::IN:
       return static_cast<int>(Precedence::CMP);
 
     case Op::AND:
@@ -119,7 +123,7 @@ int BinaryOperator::getPrecedence() const {
 void BinaryOperator::dump(std::ostream& stream, bool parenthesis) const {
   static const std::vector<std::string> OpStr = {
       " * ", " / ",  " % ", " + ",  " - ", " << ", " >> ",  " & ", " | ",
-      " < ", " <= ", " > ", " >= ", " = ", " <> ", " AND ", " OR "};
+      " < ", " <= ", " > ", " >= ", " = ", " <> ", " AND ", " OR ", " IN "};
 
   if (parenthesis) stream << "(";
   left->dump(stream, getPrecedence() > left->getPrecedence());
@@ -128,6 +132,139 @@ void BinaryOperator::dump(std::ostream& stream, bool parenthesis) const {
   if (parenthesis) stream << ")";
 }
 
+Ordering::Ordering(Order order, const Node::Ptr& child)
+    : order(order), child(child->clone()) {}
+
+Ordering::Ordering(Order order, Node::Ptr&& child)
+    : order(order), child(move(child)) {}
+
+Ordering::Ordering(const Ordering& other)
+    : order(other.order), child(other.child->clone()) {}
+
+Ordering::~Ordering() = default;
+
+int Ordering::getPrecedence() const {
+  return static_cast<int>(Precedence::OR);
+}
+
+void Ordering::dump(std::ostream& stream, bool parenthesis) const {
+  if (parenthesis) stream << "(";
+  child->dump(stream);
+  stream << (order == Order::ASC ? " ASC" : " DESC");
+  if (parenthesis) stream << ")";
+}
+
+Function::Function(const std::string& name, bool distinct,
+                   std::vector<Node::Ptr>&& args)
+    : name(name), distinct(distinct), args(move(args)) {}
+
+Function::Function(const Function& other)
+    : name(other.name), distinct(other.distinct) {
+  for (const auto& a : other.args) args.emplace_back(a->clone());
+}
+
+Function::~Function() = default;
+
+int Function::getPrecedence() const {
+  return static_cast<int>(Precedence::VALUE);
+}
+
+void Function::dump(std::ostream& stream, bool) const {
+  stream << name << "(";
+  if (distinct) stream << "DISTINCT ";
+  bool first = true;
+  for (const auto& a : args) {
+    if (!first) stream << ", ";
+    first = false;
+    a->dump(stream);
+  }
+  stream << ")";
+}
+
+Case::Case(std::vector<Node::Ptr>&& children) : children(move(children)) {}
+
+Case::Case(const Case& other) {
+  for (const auto& c : other.children) children.emplace_back(c->clone());
+}
+
+Case::~Case() = default;
+
+int Case::getPrecedence() const { return static_cast<int>(Precedence::VALUE); }
+
+void Case::dump(std::ostream& stream, bool) const {
+  stream << "CASE";
+  size_t i = 0;
+  for (; i + 1 < children.size(); i += 2) {
+    stream << " WHEN ";
+    children[i]->dump(stream);
+    stream << " THEN ";
+    children[i + 1]->dump(stream);
+  }
+  if (i < children.size()) {
+    stream << " ELSE ";
+    children[i]->dump(stream);
+  }
+  stream << " END";
+}
+
+Over::Over(Node::Ptr&& function, std::vector<Node::Ptr>&& partition,
+           std::vector<Node::Ptr>&& order, const std::string& frame)
+    : function(move(function)),
+      partition(move(partition)),
+      order(move(order)),
+      frame(frame) {}
+
+Over::Over(const Over& other)
+    : function(other.function->clone()), frame(other.frame) {
+  for (const auto& p : other.partition) partition.emplace_back(p->clone());
+  for (const auto& o : other.order) order.emplace_back(o->clone());
+}
+
+Over::~Over() = default;
+
+int Over::getPrecedence() const { return static_cast<int>(Precedence::VALUE); }
+
+void Over::dump(std::ostream& stream, bool) const {
+  function->dump(stream);
+  stream << " OVER (";
+  bool first = true;
+  auto separate = [&](const char* clause) {
+    if (!first) stream << " ";
+    first = false;
+    stream << clause;
+  };
+  if (!partition.empty()) {
+    separate("PARTITION BY ");
+    for (size_t i = 0; i < partition.size(); ++i) {
+      if (i != 0) stream << ", ";
+      partition[i]->dump(stream);
+    }
+  }
+  if (!order.empty()) {
+    separate("ORDER BY ");
+    for (size_t i = 0; i < order.size(); ++i) {
+      if (i != 0) stream << ", ";
+      order[i]->dump(stream);
+    }
+  }
+  if (!frame.empty()) separate(frame.c_str());
+  stream << ")";
+}
+
+Subquery::Subquery(const std::string& sql) : sql(sql) {}
+
+Subquery::Subquery(const Subquery& other) = default;
+
+Subquery::~Subquery() = default;
+
+int Subquery::getPrecedence() const {
+  return static_cast<int>(Precedence::VALUE);
+}
+
+void Subquery::dump(std::ostream& stream, bool) const {
+  stream << "(" << sql << ")";
+}
+
 Data::Data() = default;
 
 Data::Data(const Data& other)
@@ -140,6 +277,57 @@ Data::Data(const std::string& table, const std::string& field)
 
 Data::Data(Bind&& bind) : root(Node::make<Leaf>()), binds({std::move(bind)}) {}
 
+Data::Data(Node::Ptr&& root, std::vector<Bind>&& binds)
+    : root(move(root)), binds(move(binds)) {}
+
+Data::Data(Node::Ptr&& root, const std::string& table)
+    : root(move(root)), tables({table}) {}
+
+Data::Data(const std::string& function, bool distinct,
+           std::vector<Data>&& args) {
+  std::vector<Node::Ptr> nodes;
+  for (auto&& a : args) {
+    nodes.emplace_back(move(a.root));
+    tables.insert(make_move_iterator(a.tables.begin()),
+                  make_move_iterator(a.tables.end()));
+    binds.insert(binds.end(), make_move_iterator(a.binds.begin()),
+                 make_move_iterator(a.binds.end()));
+  }
+  root = Node::make<Function>(function, distinct, move(nodes));
+}
+
+Data::Data(std::vector<Data>&& caseParts) {
+  std::vector<Node::Ptr> nodes;
+  for (auto&& p : caseParts) {
+    nodes.emplace_back(move(p.root));
+    tables.insert(make_move_iterator(p.tables.begin()),
+                  make_move_iterator(p.tables.end()));
+    binds.insert(binds.end(), make_move_iterator(p.binds.begin()),
+                 make_move_iterator(p.binds.end()));
+  }
+  root = Node::make<Case>(move(nodes));
+}
+
+Data::Data(Data&& function, std::vector<Data>&& partition,
+           std::vector<Data>&& order, const std::string& frame)
+    : tables(move(function.tables)), binds(move(function.binds)) {
+  auto take = [this](std::vector<Data>& items) {
+    std::vector<Node::Ptr> nodes;
+    for (auto&& i : items) {
+      nodes.emplace_back(move(i.root));
+      tables.insert(make_move_iterator(i.tables.begin()),
+                    make_move_iterator(i.tables.end()));
+      binds.insert(binds.end(), make_move_iterator(i.binds.begin()),
+                   make_move_iterator(i.binds.end()));
+    }
+    return nodes;
+  };
+  auto partitionNodes = take(partition);
+  auto orderNodes = take(order);
+  root = Node::make<Over>(move(function.root), move(partitionNodes),
+                          move(orderNodes), frame);
+}
+
 Data::Data(UnaryOperator::Op op, const Data& child)
     : root(Node::make<UnaryOperator>(op, child.root->clone())),
       tables(child.tables),
@@ -150,6 +338,16 @@ Data::Data(UnaryOperator::Op op, Data&& child)
       tables(move(child.tables)),
       binds(move(child.binds)) {}
 
+Data::Data(Order order, const Data& child)
+    : root(Node::make<Ordering>(order, child.root->clone())),
+      tables(child.tables),
+      binds(child.binds) {}
+
+Data::Data(Order order, Data&& child)
+    : root(Node::make<Ordering>(order, move(child.root))),
+      tables(move(child.tables)),
+      binds(move(child.binds)) {}
+
 Data::Data(BinaryOperator::Op op, const Data& left, const Data& right)
     : root(Node::make<BinaryOperator>(op, left.root->clone(),
                                       right.root->clone())),
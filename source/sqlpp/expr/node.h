@@ -5,12 +5,24 @@
 #include <memory>
 #include <unordered_set>
 
+#include "../timing.h"
 #include "../types.h"
 
 namespace sqlpp {
 
+enum class Order {
+  ASC,
+  DESC,
+};
+
 namespace stmt {
 
+class DeleteData;
+
+class InsertData;
+
+class ReturningData;
+
 class SelectData;
 
 class UpdateData;
@@ -25,6 +37,7 @@ class Node {
 
   template <typename T, typename... V>
   static Ptr make(V&&... v) {
+    SQLPP_TIME(BUILD);
     return Ptr(new T(std::forward<V>(v)...));
   }
 
@@ -42,6 +55,7 @@ class NodeT : public Node {
   ~NodeT() override = default;
 
   Ptr clone() const override {
+    SQLPP_TIME(BUILD);
     return Ptr(new T(static_cast<const T&>(*this)));
   }
 };
@@ -49,6 +63,7 @@ class NodeT : public Node {
 class Leaf : public NodeT<Leaf> {
  public:
   Leaf();
+  explicit Leaf(const std::string& value);
   Leaf(const std::string& table, const std::string& field);
 
   Leaf(const Leaf& other);
@@ -70,6 +85,7 @@ class UnaryOperator : public NodeT<UnaryOperator> {
     PLUS,
     COMPLEMENT,
     NOT,
+    EXISTS,
   };
 
   UnaryOperator(Op op, const Node::Ptr& child);
@@ -108,6 +124,7 @@ class BinaryOperator : public NodeT<BinaryOperator> {
     NE,
     AND,
     OR,
+    IN,
   };
 
   BinaryOperator(Op op, const Node::Ptr& left, const Node::Ptr& right);
@@ -127,6 +144,99 @@ class BinaryOperator : public NodeT<BinaryOperator> {
   Node::Ptr right;
 };
 
+class Ordering : public NodeT<Ordering> {
+ public:
+  Ordering(Order order, const Node::Ptr& child);
+  Ordering(Order order, Node::Ptr&& child);
+
+  Ordering(const Ordering& other);
+
+  ~Ordering() override;
+
+  int getPrecedence() const override;
+
+  void dump(std::ostream& stream, bool parenthesis) const override;
+
+ private:
+  const Order order;
+  Node::Ptr child;
+};
+
+// Function without a name is rendered as a row value "(a, b)"
+class Function : public NodeT<Function> {
+ public:
+  Function(const std::string& name, bool distinct,
+           std::vector<Node::Ptr>&& args);
+
+  Function(const Function& other);
+
+  ~Function() override;
+
+  int getPrecedence() const override;
+
+  void dump(std::ostream& stream, bool parenthesis) const override;
+
+ private:
+  const std::string name;
+  const bool distinct;
+  std::vector<Node::Ptr> args;
+};
+
+// "CASE WHEN c1 THEN v1 ... ELSE e END", children are the conditions and the
+// values in turn followed by the optional ELSE value
+class Case : public NodeT<Case> {
+ public:
+  explicit Case(std::vector<Node::Ptr>&& children);
+
+  Case(const Case& other);
+
+  ~Case() override;
+
+  int getPrecedence() const override;
+
+  void dump(std::ostream& stream, bool parenthesis) const override;
+
+ private:
+  std::vector<Node::Ptr> children;
+};
+
+// Window function call "f(a) OVER (PARTITION BY b ORDER BY c frame)"
+class Over : public NodeT<Over> {
+ public:
+  Over(Node::Ptr&& function, std::vector<Node::Ptr>&& partition,
+       std::vector<Node::Ptr>&& order, const std::string& frame);
+
+  Over(const Over& other);
+
+  ~Over() override;
+
+  int getPrecedence() const override;
+
+  void dump(std::ostream& stream, bool parenthesis) const override;
+
+ private:
+  Node::Ptr function;
+  std::vector<Node::Ptr> partition;
+  std::vector<Node::Ptr> order;
+  const std::string frame;
+};
+
+class Subquery : public NodeT<Subquery> {
+ public:
+  explicit Subquery(const std::string& sql);
+
+  Subquery(const Subquery& other);
+
+  ~Subquery() override;
+
+  int getPrecedence() const override;
+
+  void dump(std::ostream& stream, bool parenthesis) const override;
+
+ private:
+  std::string sql;
+};
+
 class Data {
  public:
   Data();
@@ -135,10 +245,23 @@ class Data {
 
   Data(const std::string& table, const std::string& field);
   explicit Data(Bind&& bind);
+  Data(Node::Ptr&& root, std::vector<Bind>&& binds);
+  // Node that stands for the rows of the table, like the * of count(*)
+  Data(Node::Ptr&& root, const std::string& table);
+
+  Data(const std::string& function, bool distinct, std::vector<Data>&& args);
+
+  explicit Data(std::vector<Data>&& caseParts);
+
+  Data(Data&& function, std::vector<Data>&& partition,
+       std::vector<Data>&& order, const std::string& frame);
 
   Data(UnaryOperator::Op op, const Data& child);
   Data(UnaryOperator::Op op, Data&& child);
 
+  Data(Order order, const Data& child);
+  Data(Order order, Data&& child);
+
   Data(BinaryOperator::Op op, const Data& left, const Data& right);
   Data(BinaryOperator::Op op, Data&& left, const Data& right);
   Data(BinaryOperator::Op op, const Data& left, Data&& right);
@@ -156,6 +279,9 @@ class Data {
   std::unordered_set<std::string> tables;
   std::vector<Bind> binds;
 
+  friend class stmt::DeleteData;
+  friend class stmt::InsertData;
+  friend class stmt::ReturningData;
   friend class stmt::SelectData;
   friend class stmt::UpdateData;
 };
@@ -0,0 +1,222 @@
+#ifndef SRC_SQLPP_EXPR_SCALAR_H_
+#define SRC_SQLPP_EXPR_SCALAR_H_
+
+#include "condition.h"
+
+namespace sqlpp {
+
+namespace expr {
+
+template <typename C>
+concept IsCondition =
+    IsExpression<C> && std::is_same_v<ExprTerm<AnyExpr, C>, bool>;
+
+// Plain C++ values given to the functions below are bound as literals of the
+// type V expected at their position
+template <typename V, typename E>
+using ArgExpr = std::conditional_t<IsExpression<E>, E, Literal<V>>;
+
+template <typename V, typename E>
+decltype(auto) toExpr(E&& e) {
+  if constexpr (IsExpression<E>)
+    return std::forward<E>(e);
+  else
+    return Literal<V>(e);
+}
+
+template <typename E>
+struct ValueTermS {
+  using Type = DbType<std::remove_cvref_t<E>>;
+};
+
+template <IsExpression E>
+struct ValueTermS<E> {
+  using Type = ExprTerm<AnyExpr, E>;
+};
+
+template <typename E>
+using ValueTerm = typename ValueTermS<E>::Type;
+
+template <typename... E>
+struct LengthExpr;
+
+template <typename T>
+struct LengthExpr<Expression<T, Text>> {
+  using Tables = T;
+  using Term = Integer;
+};
+
+template <typename T>
+struct LengthExpr<Expression<T, Blob>> {
+  using Tables = T;
+  using Term = Integer;
+};
+
+template <typename... E>
+struct RealExpr;
+
+template <typename V, typename... T>
+struct RealExpr<Expression<T, V>...> {
+  using Tables = typename NumExpr<Expression<T, V>...>::Tables;
+  using Term = Real;
+};
+
+template <typename T, typename V>
+class CaseExpr : public Expression<T, V> {
+  template <typename A, typename B>
+  friend class CaseExpr;
+
+ public:
+  template <typename C, typename E>
+  CaseExpr(C&& condition, E&& value)
+      : CaseExpr(std::vector<Data>(), std::forward<C>(condition),
+                 std::forward<E>(value)) {}
+
+  template <typename C, typename E>
+  CaseExpr<types::Merge<T, ExprTables<BoolExpr, C>,
+                        ExprTables<AnyExpr, ArgExpr<V, E>>>,
+           V>
+  when(C&& condition, E&& value) const {
+    return CaseExpr<types::Merge<T, ExprTables<BoolExpr, C>,
+                                 ExprTables<AnyExpr, ArgExpr<V, E>>>,
+                    V>(std::vector<Data>(parts), std::forward<C>(condition),
+                       std::forward<E>(value));
+  }
+
+  template <typename E>
+  Expression<types::Merge<T, ExprTables<AnyExpr, ArgExpr<V, E>>>, V> orElse(
+      E&& value) const {
+    static_assert(std::is_same_v<ExprTerm<AnyExpr, ArgExpr<V, E>>, V>,
+                  "CASE values must have the same type");
+    auto res = parts;
+    res.push_back(toExpr<V>(std::forward<E>(value)).data);
+    return Expression<types::Merge<T, ExprTables<AnyExpr, ArgExpr<V, E>>>, V>(
+        Data(std::move(res)));
+  }
+
+ private:
+  template <typename C, typename E>
+  CaseExpr(std::vector<Data>&& prev, C&& condition, E&& value)
+      : Expression<T, V>(
+            append(prev, std::forward<C>(condition), std::forward<E>(value))),
+        parts(std::move(prev)) {}
+
+  template <typename C, typename E>
+  static Data append(std::vector<Data>& prev, C&& condition, E&& value) {
+    static_assert(std::is_same_v<ExprTerm<AnyExpr, ArgExpr<V, E>>, V>,
+                  "CASE values must have the same type");
+    static_assert(IsCondition<C>, "CASE conditions must be boolean");
+    prev.push_back(std::forward<C>(condition).data);
+    prev.push_back(toExpr<V>(std::forward<E>(value)).data);
+    return Data(std::vector<Data>(prev));
+  }
+
+  std::vector<Data> parts;
+};
+
+}  // namespace expr
+
+template <typename E>
+expr::ExprResult<expr::LengthExpr, E> length(E&& e) {
+  return expr::ExprResult<expr::LengthExpr, E>("length", false,
+                                               std::forward<E>(e));
+}
+
+template <typename E>
+expr::ExprResult<expr::TxtExpr, E> lower(E&& e) {
+  return expr::ExprResult<expr::TxtExpr, E>("lower", false,
+                                            std::forward<E>(e));
+}
+
+template <typename E>
+expr::ExprResult<expr::TxtExpr, E> upper(E&& e) {
+  return expr::ExprResult<expr::TxtExpr, E>("upper", false,
+                                            std::forward<E>(e));
+}
+
+template <typename E>
+expr::ExprResult<expr::TxtExpr, E> trim(E&& e) {
+  return expr::ExprResult<expr::TxtExpr, E>("trim", false, std::forward<E>(e));
+}
+
+// Positions are 1-based as in SQLite
+template <typename E>
+expr::ExprResult<expr::TxtExpr, E> substr(E&& e, Integer start) {
+  return expr::ExprResult<expr::TxtExpr, E>(
+      "substr", false, std::forward<E>(e), expr::Literal<Integer>(start));
+}
+
+template <typename E>
+expr::ExprResult<expr::TxtExpr, E> substr(E&& e, Integer start,
+                                          Integer length) {
+  return expr::ExprResult<expr::TxtExpr, E>(
+      "substr", false, std::forward<E>(e), expr::Literal<Integer>(start),
+      expr::Literal<Integer>(length));
+}
+
+template <typename E>
+expr::ExprResult<expr::NumExpr, E> abs(E&& e) {
+  return expr::ExprResult<expr::NumExpr, E>("abs", false, std::forward<E>(e));
+}
+
+template <typename E>
+expr::ExprResult<expr::RealExpr, E> round(E&& e) {
+  return expr::ExprResult<expr::RealExpr, E>("round", false,
+                                             std::forward<E>(e));
+}
+
+template <typename E>
+expr::ExprResult<expr::RealExpr, E> round(E&& e, Integer digits) {
+  return expr::ExprResult<expr::RealExpr, E>(
+      "round", false, std::forward<E>(e), expr::Literal<Integer>(digits));
+}
+
+template <typename E, typename... EE>
+using CoalesceResult =
+    expr::ExprResult<expr::AnyExpr, E,
+                     expr::ArgExpr<expr::ExprTerm<expr::AnyExpr, E>, EE>...>;
+
+template <typename E, typename E2, typename... EE>
+CoalesceResult<E, E2, EE...> coalesce(E&& e, E2&& e2, EE&&... ee) {
+  using V = expr::ExprTerm<expr::AnyExpr, E>;
+  return CoalesceResult<E, E2, EE...>(
+      "coalesce", false, std::forward<E>(e),
+      expr::toExpr<V>(std::forward<E2>(e2)),
+      expr::toExpr<V>(std::forward<EE>(ee))...);
+}
+
+// Scalar forms taking several arguments, single argument ones are aggregates
+template <typename E, typename E2, typename... EE>
+CoalesceResult<E, E2, EE...> min(E&& e, E2&& e2, EE&&... ee) {
+  using V = expr::ExprTerm<expr::AnyExpr, E>;
+  return CoalesceResult<E, E2, EE...>("min", false, std::forward<E>(e),
+                                      expr::toExpr<V>(std::forward<E2>(e2)),
+                                      expr::toExpr<V>(std::forward<EE>(ee))...);
+}
+
+template <typename E, typename E2, typename... EE>
+CoalesceResult<E, E2, EE...> max(E&& e, E2&& e2, EE&&... ee) {
+  using V = expr::ExprTerm<expr::AnyExpr, E>;
+  return CoalesceResult<E, E2, EE...>("max", false, std::forward<E>(e),
+                                      expr::toExpr<V>(std::forward<E2>(e2)),
+                                      expr::toExpr<V>(std::forward<EE>(ee))...);
+}
+
+template <typename C, typename E>
+using CaseResult =
+    expr::CaseExpr<types::Merge<expr::ExprTables<expr::BoolExpr, C>,
+                                expr::ExprTables<expr::AnyExpr,
+                                                 expr::ArgExpr<
+                                                     expr::ValueTerm<E>, E>>>,
+                   expr::ValueTerm<E>>;
+
+// caseWhen(c1, v1).when(c2, v2).orElse(v3), the result is NULL when no
+// condition holds and orElse() is omitted
+template <typename C, typename E>
+CaseResult<C, E> caseWhen(C&& condition, E&& value) {
+  return CaseResult<C, E>(std::forward<C>(condition), std::forward<E>(value));
+}
+
+}  // namespace sqlpp
+
+#endif /* SRC_SQLPP_EXPR_SCALAR_H_ */
@@ -0,0 +1,36 @@
+#ifndef SRC_SQLPP_EXPR_SUBQUERY_H_
+#define SRC_SQLPP_EXPR_SUBQUERY_H_
+
+#include "condition.h"
+
+namespace sqlpp {
+
+namespace expr {
+
+template <typename... O>
+using OuterTables = types::MakeSet<TableType<O>...>;
+
+}  // namespace expr
+
+// Outer tables make the subquery correlated: they are not listed in its FROM
+// and the resulting expression belongs to the outer query tables
+template <typename S, typename... O>
+auto scalar(const S& select, const O&... outer) {
+  using Values = typename S::Values;
+  static_assert(types::Size<Values> == 1,
+                "Scalar subquery must return exactly one column");
+  return expr::SubqueryExpr<expr::OuterTables<O...>,
+                            DbType<types::Head<Values>>>(select, outer...);
+}
+
+template <typename S, typename... O>
+expr::Condition<expr::OuterTables<O...>> exists(const S& select,
+                                                const O&... outer) {
+  return expr::Condition<expr::OuterTables<O...>>(
+      expr::UnaryOperator::Op::EXISTS,
+      expr::SubqueryExpr<expr::OuterTables<O...>, Integer>(select, outer...));
+}
+
+}  // namespace sqlpp
+
+#endif /* SRC_SQLPP_EXPR_SUBQUERY_H_ */
@@ -0,0 +1,195 @@
+#ifndef SRC_SQLPP_EXPR_WINDOW_H_
+#define SRC_SQLPP_EXPR_WINDOW_H_
+
+#include <algorithm>
+#include <iterator>
+
+#include "expression.h"
+
+namespace sqlpp {
+
+namespace expr {
+
+// Part of a window definition given to over(), T lists the tables it refers to
+template <typename T>
+class Window {
+  template <typename A>
+  friend class Window;
+
+  template <typename A, typename B>
+  friend class WindowFunction;
+
+ public:
+  using Tables = T;
+
+  template <typename... E>
+  static Window<T> partitionBy(E&&... e) {
+    Window<T> res;
+    (res.partition.push_back(std::forward<E>(e).data), ...);
+    return res;
+  }
+
+  template <typename... E>
+  static Window<T> orderBy(E&&... e) {
+    Window<T> res;
+    (res.order.push_back(std::forward<E>(e).data), ...);
+    return res;
+  }
+
+  static Window<T> frame(const std::string& frame) {
+    Window<T> res;
+    res.frameSpec = frame;
+    return res;
+  }
+
+ private:
+  Window() = default;
+
+  template <typename A>
+  void add(Window<A>&& other) {
+    std::move(other.partition.begin(), other.partition.end(),
+              std::back_inserter(partition));
+    std::move(other.order.begin(), other.order.end(),
+              std::back_inserter(order));
+    if (!other.frameSpec.empty()) frameSpec = std::move(other.frameSpec);
+  }
+
+  std::vector<Data> partition;
+  std::vector<Data> order;
+  std::string frameSpec;
+};
+
+// Function that is only valid with an OVER clause, e.g. row_number()
+template <typename T, typename V>
+class WindowFunction {
+ public:
+  explicit WindowFunction(Data&& data) : data(std::move(data)) {}
+
+  template <typename... E>
+  WindowFunction(const std::string& function, E&&... args)
+      : data(Expression<T, V>(function, false, std::forward<E>(args)...).data) {
+  }
+
+  template <typename... W>
+  Expression<types::Merge<T, typename W::Tables...>, V> over(
+      W... parts) const {
+    Window<types::List<>> window;
+    (window.add(std::move(parts)), ...);
+    return Expression<types::Merge<T, typename W::Tables...>, V>(
+        Data(Data(data), std::move(window.partition), std::move(window.order),
+             window.frameSpec));
+  }
+
+ private:
+  Data data;
+};
+
+// Aggregate function, which may be used as a window function as well
+template <typename T, typename V>
+class Aggregate : public Expression<T, V> {
+ public:
+  using Expression<T, V>::Expression;
+
+  template <typename... W>
+  Expression<types::Merge<T, typename W::Tables...>, V> over(
+      W&&... parts) const {
+    return WindowFunction<T, V>(Data(this->data))
+        .over(std::forward<W>(parts)...);
+  }
+};
+
+template <template <typename...> typename S, typename... E>
+using AggregateResult = Aggregate<ExprTables<S, E...>, ExprTerm<S, E...>>;
+
+struct FrameBound {
+  std::string sql;
+};
+
+}  // namespace expr
+
+template <typename... E>
+expr::Window<expr::ExprTables<expr::AllExpr, E...>> partitionBy(E&&... e) {
+  return expr::Window<expr::ExprTables<expr::AllExpr, E...>>::partitionBy(
+      std::forward<E>(e)...);
+}
+
+template <typename... E>
+expr::Window<expr::OrderTables<E...>> orderBy(E&&... e) {
+  return expr::Window<expr::OrderTables<E...>>::orderBy(std::forward<E>(e)...);
+}
+
+inline expr::FrameBound preceding(size_t n) {
+  return {std::to_string(n) + " PRECEDING"};
+}
+
+inline expr::FrameBound following(size_t n) {
+  return {std::to_string(n) + " FOLLOWING"};
+}
+
+inline expr::FrameBound currentRow() { return {"CURRENT ROW"}; }
+
+inline expr::FrameBound unboundedPreceding() {
+  return {"UNBOUNDED PRECEDING"};
+}
+
+inline expr::FrameBound unboundedFollowing() {
+  return {"UNBOUNDED FOLLOWING"};
+}
+
+inline expr::Window<types::List<>> rowsBetween(const expr::FrameBound& start,
+                                               const expr::FrameBound& end) {
+  return expr::Window<types::List<>>::frame("ROWS BETWEEN " + start.sql +
+                                            " AND " + end.sql);
+}
+
+inline expr::Window<types::List<>> rangeBetween(const expr::FrameBound& start,
+                                                const expr::FrameBound& end) {
+  return expr::Window<types::List<>>::frame("RANGE BETWEEN " + start.sql +
+                                            " AND " + end.sql);
+}
+
+inline expr::WindowFunction<types::List<>, Integer> rowNumber() {
+  return expr::WindowFunction<types::List<>, Integer>("row_number");
+}
+
+inline expr::WindowFunction<types::List<>, Integer> rank() {
+  return expr::WindowFunction<types::List<>, Integer>("rank");
+}
+
+inline expr::WindowFunction<types::List<>, Integer> denseRank() {
+  return expr::WindowFunction<types::List<>, Integer>("dense_rank");
+}
+
+template <typename E>
+using WindowValue = expr::WindowFunction<expr::ExprTables<expr::AnyExpr, E>,
+                                         expr::ExprTerm<expr::AnyExpr, E>>;
+
+template <typename E>
+WindowValue<E> lag(E&& e, Integer offset = 1) {
+  return WindowValue<E>("lag", std::forward<E>(e),
+                        expr::Literal<Integer>(offset));
+}
+
+template <typename E, typename U>
+WindowValue<E> lag(E&& e, Integer offset, const U& defaultValue) {
+  return WindowValue<E>(
+      "lag", std::forward<E>(e), expr::Literal<Integer>(offset),
+      expr::Literal<expr::ExprTerm<expr::AnyExpr, E>>(defaultValue));
+}
+
+template <typename E>
+WindowValue<E> lead(E&& e, Integer offset = 1) {
+  return WindowValue<E>("lead", std::forward<E>(e),
+                        expr::Literal<Integer>(offset));
+}
+
+template <typename E, typename U>
+WindowValue<E> lead(E&& e, Integer offset, const U& defaultValue) {
+  return WindowValue<E>(
+      "lead", std::forward<E>(e), expr::Literal<Integer>(offset),
+      expr::Literal<expr::ExprTerm<expr::AnyExpr, E>>(defaultValue));
+}
+
+}  // namespace sqlpp
+
+#endif /* SRC_SQLPP_EXPR_WINDOW_H_ */
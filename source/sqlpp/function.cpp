@@ -0,0 +1,78 @@
+#include "function.h"
+
+#include <sqlite3.h>
+
+#include <stdexcept>
+
+namespace sqlpp {
+
+bool isNull(sqlite3_value* value) {
+  return sqlite3_value_type(value) == SQLITE_NULL;
+}
+
+void read(sqlite3_value* value, Integer& res) {
+  res = sqlite3_value_int64(value);
+}
+
+void read(sqlite3_value* value, Real& res) {
+  res = sqlite3_value_double(value);
+}
+
+void read(sqlite3_value* value, Text& res) {
+  auto text = reinterpret_cast<const char*>(sqlite3_value_text(value));
+  res.assign(text, sqlite3_value_bytes(value));
+}
+
+void read(sqlite3_value* value, Blob& res) {
+  size_t size = sqlite3_value_bytes(value);
+  auto ptr = static_cast<const std::byte*>(sqlite3_value_blob(value));
+  if (size != 0) res.assign(ptr, ptr + size);
+}
+
+void result(sqlite3_context* ctx, const Integer& value) {
+  sqlite3_result_int64(ctx, value);
+}
+
+void result(sqlite3_context* ctx, const Real& value) {
+  sqlite3_result_double(ctx, value);
+}
+
+void result(sqlite3_context* ctx, const Text& value) {
+  sqlite3_result_text64(ctx, value.data(), value.size(), SQLITE_TRANSIENT,
+                        SQLITE_UTF8);
+}
+
+void result(sqlite3_context* ctx, const Blob& value) {
+  sqlite3_result_blob64(ctx, value.data(), value.size(), SQLITE_TRANSIENT);
+}
+
+void resultNull(sqlite3_context* ctx) { sqlite3_result_null(ctx); }
+
+void resultError(sqlite3_context* ctx, const std::string& message) {
+  sqlite3_result_error(ctx, message.c_str(), message.size());
+}
+
+void* functionData(sqlite3_context* ctx) { return sqlite3_user_data(ctx); }
+
+void* aggregateData(sqlite3_context* ctx, size_t size) {
+  return sqlite3_aggregate_context(ctx, size);
+}
+
+void Database::createFunction(const std::string& name, int argCount,
+                              bool deterministic, void* data,
+                              FunctionCallback function, FunctionCallback step,
+                              FinalCallback final,
+                              void (*destroy)(void*)) const {
+  int flags = SQLITE_UTF8;
+  if (deterministic) flags |= SQLITE_DETERMINISTIC;
+  // The destructor is called by SQLite even if the registration fails
+  auto rc = sqlite3_create_function_v2(db, name.c_str(), argCount, flags, data,
+                                       function, step, final, destroy);
+  if (rc != SQLITE_OK) {
+    std::string err(sqlite3_errmsg(db));
+    throw std::runtime_error("Cannot register function \"" + name +
+                             "\": " + err);
+  }
+}
+
+}  // namespace sqlpp
@@ -0,0 +1,227 @@
+#ifndef SQLPP_FUNCTION_H_
+#define SQLPP_FUNCTION_H_
+
+#include <memory>
+#include <utility>
+
+#include "database.h"
+#include "expr/scalar.h"
+
+struct sqlite3_context;
+struct sqlite3_value;
+
+namespace sqlpp {
+
+bool isNull(sqlite3_value* value);
+
+void read(sqlite3_value* value, Integer& res);
+void read(sqlite3_value* value, Real& res);
+void read(sqlite3_value* value, Text& res);
+void read(sqlite3_value* value, Blob& res);
+
+void result(sqlite3_context* ctx, const Integer& value);
+void result(sqlite3_context* ctx, const Real& value);
+void result(sqlite3_context* ctx, const Text& value);
+void result(sqlite3_context* ctx, const Blob& value);
+void resultNull(sqlite3_context* ctx);
+void resultError(sqlite3_context* ctx, const std::string& message);
+
+void* functionData(sqlite3_context* ctx);
+void* aggregateData(sqlite3_context* ctx, size_t size);
+
+// Typed call of a function registered in the database; arguments are either
+// expressions or C++ values of the registered argument types
+template <typename R, typename... A>
+class UserFunction {
+ public:
+  using Result = DbType<R>;
+
+  explicit UserFunction(const std::string& name) : name(name) {}
+
+  const std::string& getName() const { return name; }
+
+  template <typename... E>
+  expr::Expression<
+      types::Merge<types::List<>,
+                   expr::ExprTables<expr::AnyExpr,
+                                    expr::ArgExpr<DbType<A>, E>>...>,
+      Result>
+  operator()(E&&... args) const {
+    static_assert(sizeof...(E) == sizeof...(A),
+                  "Arguments count does not match to the function");
+    static_assert((std::is_same_v<expr::ValueTerm<E>, DbType<A>> && ...),
+                  "Argument type does not match to the function");
+    return expr::Expression<
+        types::Merge<types::List<>,
+                     expr::ExprTables<expr::AnyExpr,
+                                      expr::ArgExpr<DbType<A>, E>>...>,
+        Result>(name, false, expr::toExpr<DbType<A>>(std::forward<E>(args))...);
+  }
+
+ private:
+  std::string name;
+};
+
+namespace func {
+
+template <typename F>
+struct CallableS : CallableS<decltype(&F::operator())> {};
+
+template <typename R, typename... A>
+struct CallableS<R (*)(A...)> {
+  using Result = R;
+  using Args = types::List<std::remove_cvref_t<A>...>;
+};
+
+template <typename C, typename R, typename... A>
+struct CallableS<R (C::*)(A...)> : CallableS<R (*)(A...)> {};
+
+template <typename C, typename R, typename... A>
+struct CallableS<R (C::*)(A...) const> : CallableS<R (*)(A...)> {};
+
+template <typename F>
+using Result = typename CallableS<std::decay_t<F>>::Result;
+
+template <typename F>
+using Args = typename CallableS<std::decay_t<F>>::Args;
+
+template <typename A>
+A argument(sqlite3_value* value) {
+  DbType<A> res;
+  read(value, res);
+  return fromDb<A>(res);
+}
+
+// SQL NULL in any argument makes the result NULL as for built-in functions
+inline bool hasNull(int argc, sqlite3_value** argv) {
+  for (int i = 0; i < argc; ++i)
+    if (isNull(argv[i])) return true;
+  return false;
+}
+
+// No exception may unwind through the SQLite frames that call these
+template <typename F, typename... A>
+struct Scalar {
+  struct Data {
+    std::string name;
+    F function;
+  };
+
+  static void call(sqlite3_context* ctx, int argc, sqlite3_value** argv) {
+    if (hasNull(argc, argv)) return resultNull(ctx);
+    auto& data = *static_cast<Data*>(functionData(ctx));
+    try {
+      invoke(ctx, data.function, argv, std::index_sequence_for<A...>());
+    } catch (const std::exception& e) {
+      resultError(ctx, e.what());
+    } catch (...) {
+      resultError(ctx, "Unknown error in " + data.name);
+    }
+  }
+
+  static void destroy(void* data) { delete static_cast<Data*>(data); }
+
+ private:
+  template <size_t... I>
+  static void invoke(sqlite3_context* ctx, F& f, sqlite3_value** argv,
+                     std::index_sequence<I...>) {
+    result(ctx, toDb(f(argument<A>(argv[I])...)));
+  }
+};
+
+// State is created by the first step and destroyed by the final call, SQLite
+// makes the final call for every aggregate it has started
+template <typename S, typename F, typename G, typename... A>
+struct Aggregate {
+  struct Data {
+    std::string name;
+    F step;
+    G final;
+  };
+
+  static void step(sqlite3_context* ctx, int argc, sqlite3_value** argv) {
+    if (hasNull(argc, argv)) return;
+    auto state = static_cast<S**>(aggregateData(ctx, sizeof(S*)));
+    if (!state) return resultError(ctx, "Out of memory");
+    auto& data = *static_cast<Data*>(functionData(ctx));
+    try {
+      if (!*state) *state = new S();
+      invoke(data.step, **state, argv, std::index_sequence_for<A...>());
+    } catch (const std::exception& e) {
+      resultError(ctx, e.what());
+    } catch (...) {
+      resultError(ctx, "Unknown error in " + data.name);
+    }
+  }
+
+  static void final(sqlite3_context* ctx) {
+    auto state = static_cast<S**>(aggregateData(ctx, 0));
+    std::unique_ptr<S> s(state ? *state : nullptr);
+    auto& data = *static_cast<Data*>(functionData(ctx));
+    try {
+      result(ctx, toDb(s ? data.final(*s) : data.final(S())));
+    } catch (const std::exception& e) {
+      resultError(ctx, e.what());
+    } catch (...) {
+      resultError(ctx, "Unknown error in " + data.name);
+    }
+  }
+
+  static void destroy(void* data) { delete static_cast<Data*>(data); }
+
+ private:
+  template <size_t... I>
+  static void invoke(F& f, S& s, sqlite3_value** argv,
+                     std::index_sequence<I...>) {
+    f(s, argument<A>(argv[I])...);
+  }
+};
+
+template <typename F, typename L>
+struct ScalarS;
+
+template <typename F, typename... A>
+struct ScalarS<F, types::List<A...>> {
+  using Type = Scalar<F, A...>;
+  using Function = UserFunction<Result<F>, A...>;
+};
+
+template <typename S, typename F, typename G, typename L>
+struct AggregateS;
+
+template <typename S, typename F, typename G, typename... A>
+struct AggregateS<S, F, G, types::List<S, A...>> {
+  using Type = Aggregate<S, F, G, A...>;
+  using Function = UserFunction<Result<G>, A...>;
+};
+
+}  // namespace func
+
+template <typename F>
+auto Database::registerFunction(const std::string& name, F&& function,
+                                bool deterministic) const {
+  using Impl = func::ScalarS<std::decay_t<F>, func::Args<F>>;
+  static_assert(!std::is_void_v<func::Result<F>>,
+                "Function must return a value");
+  createFunction(name, types::Size<func::Args<F>>, deterministic,
+                 new typename Impl::Type::Data{name, std::forward<F>(function)},
+                 &Impl::Type::call, nullptr, nullptr, &Impl::Type::destroy);
+  return typename Impl::Function(name);
+}
+
+template <typename S, typename F, typename G>
+auto Database::registerAggregate(const std::string& name, F&& step, G&& final,
+                                 bool deterministic) const {
+  using Impl = func::AggregateS<S, std::decay_t<F>, std::decay_t<G>,
+                                func::Args<F>>;
+  createFunction(name, types::Size<func::Args<F>> - 1, deterministic,
+                 new typename Impl::Type::Data{name, std::forward<F>(step),
+                                               std::forward<G>(final)},
+                 nullptr, &Impl::Type::step, &Impl::Type::final,
+                 &Impl::Type::destroy);
+  return typename Impl::Function(name);
+}
+
+}  // namespace sqlpp
+
+#endif /* SQLPP_FUNCTION_H_ */
@@ -0,0 +1,132 @@
+#include "plan.h"
+
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+namespace sqlpp {
+
+static bool startsWith(const std::string& str, const std::string& prefix) {
+  return str.compare(0, prefix.size(), prefix) == 0;
+}
+
+static std::string word(const std::string& str, size_t pos) {
+  return str.substr(pos, str.find(' ', pos) - pos);
+}
+
+// Constraints like "(a=? AND b>?)" depend on the bound values only through
+// the query text, so they are left out of the plan shape
+static std::string withoutConstraints(const std::string& detail) {
+  if (detail.empty() || detail.back() != ')') return detail;
+  auto pos = detail.rfind(" (");
+  return pos == std::string::npos ? detail : detail.substr(0, pos);
+}
+
+static PlanNode parse(int id, const std::string& detail) {
+  PlanNode node;
+  node.id = id;
+  node.detail = detail;
+
+  if (startsWith(detail, "USE TEMP B-TREE")) {
+    node.kind = PlanNode::Kind::TempBTree;
+    return node;
+  }
+
+  size_t pos;
+  if (startsWith(detail, "SCAN ") && detail != "SCAN CONSTANT ROW") {
+    node.kind = PlanNode::Kind::Scan;
+    pos = 5;
+  } else if (startsWith(detail, "SEARCH ")) {
+    node.kind = PlanNode::Kind::Search;
+    pos = 7;
+  } else {
+    return node;
+  }
+  node.table = word(detail, pos);
+
+  pos = detail.find(" USING ", pos);
+  if (pos == std::string::npos) return node;
+  auto using_ = withoutConstraints(detail.substr(pos + 7));
+  if (startsWith(using_, "COVERING ")) {
+    node.covering = true;
+    using_ = using_.substr(9);
+  }
+  node.index = startsWith(using_, "INDEX ") ? word(using_, 6) : using_;
+  return node;
+}
+
+Plan::Plan(Result&& result) {
+  struct Row {
+    int parent;
+    PlanNode node;
+  };
+  std::vector<Row> rows;
+  for (; result.hasData(); result.next()) {
+    auto id = static_cast<int>(result.as<Integer>(0).value_or(0));
+    auto parent = static_cast<int>(result.as<Integer>(1).value_or(0));
+    rows.push_back({parent, parse(id, result.as<Text>(3).value_or(""))});
+  }
+  if (!result)
+    throw std::runtime_error("Failed to read the query plan");
+
+  // Rows come in depth first order, so a parent is always before its children
+  std::function<void(std::vector<PlanNode>&, int, size_t&)> build =
+      [&](std::vector<PlanNode>& nodes, int parent, size_t& i) {
+        while (i < rows.size() && rows[i].parent == parent) {
+          auto& node = nodes.emplace_back(std::move(rows[i].node));
+          ++i;
+          build(node.children, node.id, i);
+        }
+      };
+  size_t i = 0;
+  build(roots, 0, i);
+  if (i != rows.size())
+    throw std::runtime_error("Unexpected query plan structure");
+}
+
+static bool any(const std::vector<PlanNode>& nodes,
+                const std::function<bool(const PlanNode&)>& pred) {
+  for (const auto& node : nodes)
+    if (pred(node) || any(node.children, pred)) return true;
+  return false;
+}
+
+bool Plan::scans(const std::string& table) const {
+  return any(roots, [&](const PlanNode& node) {
+    return node.kind == PlanNode::Kind::Scan && node.table == table;
+  });
+}
+
+bool Plan::usesIndex(const std::string& index) const {
+  return any(roots, [&](const PlanNode& node) { return node.index == index; });
+}
+
+bool Plan::usesTempBTree() const {
+  return any(roots, [](const PlanNode& node) {
+    return node.kind == PlanNode::Kind::TempBTree;
+  });
+}
+
+static void dump(std::ostream& stream, const std::vector<PlanNode>& nodes,
+                 size_t depth, bool& first) {
+  for (const auto& node : nodes) {
+    if (!first) stream << "\n";
+    first = false;
+    stream << std::string(2 * depth, ' ') << withoutConstraints(node.detail);
+    dump(stream, node.children, depth + 1, first);
+  }
+}
+
+std::string Plan::shape() const {
+  std::ostringstream ss;
+  ss << *this;
+  return ss.str();
+}
+
+std::ostream& operator<<(std::ostream& stream, const Plan& plan) {
+  bool first = true;
+  dump(stream, plan.nodes(), 0, first);
+  return stream;
+}
+
+}  // namespace sqlpp
@@ -0,0 +1,55 @@
+#ifndef SQLPP_PLAN_H_
+#define SQLPP_PLAN_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "result.h"
+
+namespace sqlpp {
+
+// One row of EXPLAIN QUERY PLAN with the rows nested under it
+struct PlanNode {
+  enum class Kind { Scan, Search, TempBTree, Other };
+
+  int id = 0;
+  Kind kind = Kind::Other;
+  // Table of a scan or search
+  std::string table;
+  // Index name, or the key used for a search such as INTEGER PRIMARY KEY
+  std::string index;
+  bool covering = false;
+  std::string detail;
+  std::vector<PlanNode> children;
+};
+
+class Plan {
+ public:
+  Plan() = default;
+  // Reads the id, parent, notused, detail rows of EXPLAIN QUERY PLAN
+  explicit Plan(Result&& result);
+
+  const std::vector<PlanNode>& nodes() const { return roots; }
+
+  // True if the table is read by a scan instead of a search
+  bool scans(const std::string& table) const;
+  bool usesIndex(const std::string& index) const;
+  // True for a temp b-tree of ORDER BY, GROUP BY or DISTINCT
+  bool usesTempBTree() const;
+
+  // Details without the search constraints, one line per node with two
+  // spaces of indentation per level, e.g.
+  //   SEARCH Users USING INDEX users_name
+  //   USE TEMP B-TREE FOR ORDER BY
+  std::string shape() const;
+
+ private:
+  std::vector<PlanNode> roots;
+};
+
+std::ostream& operator<<(std::ostream& stream, const Plan& plan);
+
+}  // namespace sqlpp
+
+#endif /* SQLPP_PLAN_H_ */
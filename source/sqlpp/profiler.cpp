@@ -0,0 +1,196 @@
+#include "profiler.h"
+
+#include <sqlite3.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <string_view>
+
+namespace sqlpp {
+
+static bool isWord(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+// Whether the normalized text ends in a second item of an IN list, other
+// lists like VALUES rows and function arguments keep their arity
+static bool inListTail(const std::string& res) {
+  constexpr std::string_view tail = "(?, ?";
+  if (!res.ends_with(tail)) return false;
+  size_t end = res.size() - tail.size();
+  if (end > 0 && res[end - 1] == ' ') --end;
+  if (end < 2 || (end > 2 && isWord(res[end - 3]))) return false;
+  auto upper = [](char c) {
+    return std::toupper(static_cast<unsigned char>(c));
+  };
+  return upper(res[end - 2]) == 'I' && upper(res[end - 1]) == 'N';
+}
+
+std::string fingerprint(const std::string& sql) {
+  std::string res;
+  res.reserve(sql.size());
+  for (size_t i = 0; i < sql.size();) {
+    char c = sql[i];
+    bool wordBefore = !res.empty() && isWord(res.back());
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      if (!res.empty() && res.back() != ' ') res += ' ';
+      ++i;
+    } else if (c == '\'' || ((c == 'x' || c == 'X') && !wordBefore &&
+                             i + 1 < sql.size() && sql[i + 1] == '\'')) {
+      if (c != '\'') ++i;
+      for (++i; i < sql.size(); ++i) {
+        if (sql[i] != '\'') continue;
+        if (i + 1 < sql.size() && sql[i + 1] == '\'')
+          ++i;
+        else
+          break;
+      }
+      res += '?';
+      ++i;
+    } else if (std::isdigit(static_cast<unsigned char>(c)) && !wordBefore) {
+      while (i < sql.size() && (isWord(sql[i]) || sql[i] == '.')) ++i;
+      res += '?';
+    } else if (c == '"' || c == '`' || c == '[') {
+      char end = c == '[' ? ']' : c;
+      auto pos = sql.find(end, i + 1);
+      pos = pos == std::string::npos ? sql.size() : pos + 1;
+      res.append(sql, i, pos - i);
+      i = pos;
+    } else {
+      res += c;
+      ++i;
+    }
+
+    // IN lists of any length share the fingerprint
+    if (inListTail(res)) res.resize(res.size() - 3);
+  }
+  if (!res.empty() && res.back() == ' ') res.pop_back();
+  return res;
+}
+
+Profiler::Profiler(std::chrono::nanoseconds slowThreshold, size_t slowLogSize)
+    : slowThreshold(slowThreshold), slowLogSize(slowLogSize) {}
+
+std::vector<QueryProfile> Profiler::snapshot(size_t limit) const {
+  std::vector<QueryProfile> res;
+  {
+    std::lock_guard lock(mutex);
+    res.reserve(entries.size());
+    for (const auto& [sql, entry] : entries) {
+      auto& profile = res.emplace_back();
+      profile.fingerprint = sql;
+      profile.calls = entry.calls;
+      profile.rows = entry.rows;
+      profile.total = entry.total;
+      profile.stats = entry.stats;
+      profile.p50 = std::chrono::nanoseconds(
+          std::llround(entry.latencies.quantile(0.5)));
+      profile.p99 = std::chrono::nanoseconds(
+          std::llround(entry.latencies.quantile(0.99)));
+    }
+  }
+  std::sort(res.begin(), res.end(),
+            [](const QueryProfile& a, const QueryProfile& b) {
+              return a.total > b.total ||
+                     (a.total == b.total && a.fingerprint < b.fingerprint);
+            });
+  if (res.size() > limit) res.resize(limit);
+  return res;
+}
+
+std::vector<SlowQuery> Profiler::slowQueries() const {
+  std::lock_guard lock(mutex);
+  return {slow.begin(), slow.end()};
+}
+
+void Profiler::reset() {
+  std::lock_guard lock(mutex);
+  entries.clear();
+  slow.clear();
+}
+
+void Profiler::report(std::ostream& stream, size_t limit) const {
+  auto ms = [](std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+  };
+  auto flags = stream.flags();
+  stream << std::setw(8) << "calls" << std::setw(10) << "rows"
+         << std::setw(12) << "total ms" << std::setw(10) << "p50 ms"
+         << std::setw(10) << "p99 ms" << std::setw(10) << "fullscan"
+         << std::setw(7) << "sorts" << std::setw(9) << "autoidx"
+         << "  statement\n";
+  stream << std::fixed << std::setprecision(3);
+  for (const auto& p : snapshot(limit))
+    stream << std::setw(8) << p.calls << std::setw(10) << p.rows
+           << std::setw(12) << ms(p.total) << std::setw(10) << ms(p.p50)
+           << std::setw(10) << ms(p.p99) << std::setw(10)
+           << p.stats.fullscanSteps << std::setw(7) << p.stats.sorts
+           << std::setw(9) << p.stats.autoindexes << "  " << p.fingerprint
+           << "\n";
+  stream.flags(flags);
+}
+
+int Profiler::trace(unsigned type, void* context, void* p, void* x) {
+  auto profiler = static_cast<Profiler*>(context);
+  auto stmt = static_cast<sqlite3_stmt*>(p);
+  if (type == SQLITE_TRACE_STMT) {
+    // Triggers report their start as a "-- TRIGGER" comment
+    if (std::string_view(static_cast<const char*>(x)).starts_with("--"))
+      return 0;
+    auto now = std::chrono::steady_clock::now();
+    std::lock_guard lock(profiler->mutex);
+    profiler->running[stmt] = {now, 0};
+  } else if (type == SQLITE_TRACE_ROW) {
+    std::lock_guard lock(profiler->mutex);
+    ++profiler->running[stmt].rows;
+  } else if (type == SQLITE_TRACE_PROFILE) {
+    auto time = std::chrono::nanoseconds(*static_cast<sqlite3_int64*>(x));
+    profiler->profile(stmt, time);
+  }
+  return 0;
+}
+
+// SQLite measures the profile time with the VFS clock, which has millisecond
+// resolution, so the time since SQLITE_TRACE_STMT is used when it is known
+void Profiler::profile(sqlite3_stmt* stmt, std::chrono::nanoseconds time) {
+  auto now = std::chrono::steady_clock::now();
+  {
+    std::lock_guard lock(mutex);
+    if (auto it = running.find(stmt); it != running.end())
+      time = std::max(time, std::chrono::nanoseconds(now - it->second.start));
+  }
+
+  auto sql = sqlite3_sql(stmt);
+  auto key = fingerprint(sql ? sql : "");
+
+  std::string expanded;
+  if (time >= slowThreshold && slowLogSize != 0) {
+    auto text = sqlite3_expanded_sql(stmt);
+    expanded = text ? text : key;
+    sqlite3_free(text);
+  }
+
+  // Every Result prepares its own statement, so the counters belong to one
+  // run and stay readable through Result::stats()
+  auto stats = statementStats(stmt, false);
+
+  std::lock_guard lock(mutex);
+  auto& entry = entries[key];
+  entry.stats += stats;
+  ++entry.calls;
+  entry.total += time;
+  entry.latencies.add(static_cast<double>(time.count()));
+  if (auto it = running.find(stmt); it != running.end()) {
+    entry.rows += it->second.rows;
+    running.erase(it);
+  }
+
+  if (!expanded.empty()) {
+    if (slow.size() == slowLogSize) slow.pop_front();
+    slow.push_back({std::move(expanded), time});
+  }
+}
+
+}  // namespace sqlpp
@@ -0,0 +1,90 @@
+#ifndef SQLPP_PROFILER_H_
+#define SQLPP_PROFILER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "result.h"
+#include "sketch.h"
+
+struct sqlite3_stmt;
+
+namespace sqlpp {
+
+// SQL with literals replaced by "?", bind lists collapsed and whitespace
+// normalized, so all executions of a query share the fingerprint
+std::string fingerprint(const std::string& sql);
+
+struct QueryProfile {
+  std::string fingerprint;
+  uint64_t calls = 0;
+  uint64_t rows = 0;
+  std::chrono::nanoseconds total{0};
+  std::chrono::nanoseconds p50{0};
+  std::chrono::nanoseconds p99{0};
+  StatementStats stats;
+};
+
+struct SlowQuery {
+  // SQL with the bound values expanded
+  std::string sql;
+  std::chrono::nanoseconds time{0};
+};
+
+// Statement timings and engine counters collected from SQLITE_TRACE_PROFILE
+// events of a Database, see Database::startProfiling(). Latency percentiles
+// come from a t-digest, so the memory is bounded per fingerprint.
+class Profiler {
+ public:
+  Profiler(std::chrono::nanoseconds slowThreshold, size_t slowLogSize);
+  Profiler(const Profiler&) = delete;
+
+  Profiler& operator=(const Profiler&) = delete;
+
+  // Profiles sorted by the total time, the most expensive first
+  std::vector<QueryProfile> snapshot(
+      size_t limit = std::numeric_limits<size_t>::max()) const;
+  // The latest statements slower than the threshold, oldest first
+  std::vector<SlowQuery> slowQueries() const;
+  void reset();
+
+  // Table of the top statements by total time
+  void report(std::ostream& stream, size_t limit = 10) const;
+
+  static int trace(unsigned type, void* context, void* p, void* x);
+
+ private:
+  struct Entry {
+    uint64_t calls = 0;
+    uint64_t rows = 0;
+    std::chrono::nanoseconds total{0};
+    sketch::TDigest latencies;
+    StatementStats stats;
+  };
+
+  struct Running {
+    std::chrono::steady_clock::time_point start;
+    uint64_t rows = 0;
+  };
+
+  void profile(sqlite3_stmt* stmt, std::chrono::nanoseconds time);
+
+  const std::chrono::nanoseconds slowThreshold;
+  const size_t slowLogSize;
+
+  mutable std::mutex mutex;
+  std::unordered_map<std::string, Entry> entries;
+  std::unordered_map<sqlite3_stmt*, Running> running;
+  std::deque<SlowQuery> slow;
+};
+
+}  // namespace sqlpp
+
+#endif /* SQLPP_PROFILER_H_ */
@@ -2,8 +2,11 @@
 
 #include <sqlite3.h>
 
+#include <algorithm>
 #include <stdexcept>
 
+#include "timing.h"
+
 namespace sqlpp {
 
 static void initValue(Integer& val, sqlite3_stmt* stmt, size_t i) {
@@ -25,6 +28,33 @@ static void initValue(Blob& val, sqlite3_stmt* stmt, size_t i) {
   val.assign(ptr, ptr + size);
 }
 
+StatementStats& StatementStats::operator+=(const StatementStats& other) {
+  fullscanSteps += other.fullscanSteps;
+  sorts += other.sorts;
+  autoindexes += other.autoindexes;
+  vmSteps += other.vmSteps;
+  reprepares += other.reprepares;
+  runs += other.runs;
+  memoryUsed = std::max(memoryUsed, other.memoryUsed);
+  return *this;
+}
+
+StatementStats statementStats(sqlite3_stmt* stmt, bool reset) {
+  StatementStats res;
+  if (!stmt) return res;
+  res.fullscanSteps =
+      sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_FULLSCAN_STEP, reset);
+  res.sorts = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_SORT, reset);
+  res.autoindexes =
+      sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_AUTOINDEX, reset);
+  res.vmSteps = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_VM_STEP, reset);
+  res.reprepares =
+      sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_REPREPARE, reset);
+  res.runs = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_RUN, reset);
+  res.memoryUsed = sqlite3_stmt_status(stmt, SQLITE_STMTSTATUS_MEMUSED, 0);
+  return res;
+}
+
 Result::Result(sqlite3_stmt* stmt) : stmt(stmt) {}
 
 Result::Result(Result&& other) {
@@ -53,10 +83,15 @@ Result::operator bool() const {
   return status == SQLITE_DONE || status == SQLITE_ROW;
 }
 
-void Result::next() { status = sqlite3_step(stmt); }
+void Result::next() {
+  SQLPP_TIME(STEP);
+  status = sqlite3_step(stmt);
+}
 
 bool Result::hasData() const { return status == SQLITE_ROW; }
 
+StatementStats Result::stats() const { return statementStats(stmt, false); }
+
 size_t Result::count() { return sqlite3_column_count(stmt); }
 
 std::string Result::name(size_t i) {
@@ -66,6 +101,7 @@ std::string Result::name(size_t i) {
 
 template <typename R>
 std::optional<R> Result::as(size_t i) {
+  SQLPP_TIME(DECODE);
   if (i >= count()) throw std::out_of_range("Incorrect column index");
 
   std::optional<R> res;
@@ -1,15 +1,34 @@
 #ifndef SRC_SQLPP_RESULT_H_
 #define SRC_SQLPP_RESULT_H_
 
+#include <cstdint>
 #include <optional>
 #include <string>
 
+#include "timing.h"
 #include "types.h"
 
 struct sqlite3_stmt;
 
 namespace sqlpp {
 
+// Counters of sqlite3_stmt_status for a statement
+struct StatementStats {
+  int64_t fullscanSteps = 0;
+  int64_t sorts = 0;
+  int64_t autoindexes = 0;
+  int64_t vmSteps = 0;
+  int64_t reprepares = 0;
+  int64_t runs = 0;
+  // Bytes used by the prepared statement, the maximum when aggregated
+  int64_t memoryUsed = 0;
+
+  StatementStats& operator+=(const StatementStats& other);
+};
+
+// Reads the counters of the statement, reset sets them to zero afterwards
+StatementStats statementStats(sqlite3_stmt* stmt, bool reset);
+
 class Result {
  public:
   explicit Result(sqlite3_stmt* stmt);
@@ -31,6 +50,9 @@ class Result {
   size_t count();
   std::string name(size_t i);
 
+  // Engine counters of the statement so far
+  StatementStats stats() const;
+
   template <typename R>
   std::optional<R> as(size_t i);
 
@@ -57,13 +79,18 @@ class TypedResult : public Result {
 
   template <size_t N>
   auto get() {
+    SQLPP_TIME(DECODE);
     using Type = types::Get<N, TypesList>;
-    std::optional<Type> res;
 
     auto value = as<DbType<Type>>(N);
-    if (value) res = fromDb<Type>(*value);
-
-    return res;
+    // Text and blobs are not copied again when no conversion is needed
+    if constexpr (std::is_same_v<Type, DbType<Type>>) {
+      return value;
+    } else {
+      std::optional<Type> res;
+      if (value) res = fromDb<Type>(*value);
+      return res;
+    }
   }
 };
 
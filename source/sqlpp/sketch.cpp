@@ -0,0 +1,423 @@
+#include "sketch.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+namespace sqlpp {
+
+namespace sketch {
+
+static constexpr std::byte HLL_TAG{'H'};
+static constexpr std::byte TDIGEST_TAG{'T'};
+static constexpr std::byte TOPK_TAG{'K'};
+
+// Fixed width little endian encoding of the sketches
+template <typename V>
+static void write(Blob& blob, V value) {
+  uint64_t bits;
+  if constexpr (std::is_floating_point_v<V>)
+    bits = std::bit_cast<uint64_t>(static_cast<double>(value));
+  else
+    bits = static_cast<uint64_t>(value);
+  for (size_t i = 0; i < 8; ++i)
+    blob.push_back(static_cast<std::byte>(bits >> (8 * i)));
+}
+
+template <typename V>
+static V read(const Blob& blob, size_t& pos) {
+  if (pos + 8 > blob.size()) throw std::runtime_error("Truncated sketch");
+  uint64_t bits = 0;
+  for (size_t i = 0; i < 8; ++i)
+    bits |= std::to_integer<uint64_t>(blob[pos + i]) << (8 * i);
+  pos += 8;
+  if constexpr (std::is_floating_point_v<V>)
+    return std::bit_cast<double>(bits);
+  else
+    return static_cast<V>(bits);
+}
+
+static void checkTag(const Blob& blob, std::byte tag, const char* name) {
+  if (blob.empty() || blob[0] != tag)
+    throw std::runtime_error(std::string("Not a ") + name + " sketch");
+}
+
+// FNV-1a followed by the MurmurHash3 finalizer to spread the bits
+uint64_t hash(const std::string& value) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (unsigned char c : value) {
+    h ^= c;
+    h *= 0x100000001b3ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+HyperLogLog::HyperLogLog() : registers(SIZE, 0) {}
+
+void HyperLogLog::add(const std::string& value) {
+  auto h = hash(value);
+  size_t idx = h >> (64 - PRECISION);
+  uint64_t rest = (h << PRECISION) | (uint64_t(1) << (PRECISION - 1));
+  uint8_t rank = std::countl_zero(rest) + 1;
+  registers[idx] = std::max(registers[idx], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+  for (size_t i = 0; i < SIZE; ++i)
+    registers[i] = std::max(registers[i], other.registers[i]);
+}
+
+double HyperLogLog::estimate() const {
+  double sum = 0.0;
+  size_t zeros = 0;
+  for (auto r : registers) {
+    sum += std::ldexp(1.0, -r);
+    if (r == 0) ++zeros;
+  }
+  const double m = SIZE;
+  const double alpha = 0.7213 / (1.0 + 1.079 / m);
+  double res = alpha * m * m / sum;
+  if (res <= 2.5 * m && zeros != 0) res = m * std::log(m / zeros);
+  return res;
+}
+
+Blob HyperLogLog::serialize() const {
+  Blob res;
+  res.reserve(2 + SIZE);
+  res.push_back(HLL_TAG);
+  res.push_back(static_cast<std::byte>(PRECISION));
+  for (auto r : registers) res.push_back(static_cast<std::byte>(r));
+  return res;
+}
+
+HyperLogLog HyperLogLog::deserialize(const Blob& blob) {
+  checkTag(blob, HLL_TAG, "HyperLogLog");
+  if (blob.size() != 2 + SIZE ||
+      std::to_integer<unsigned>(blob[1]) != PRECISION)
+    throw std::runtime_error("Unsupported HyperLogLog sketch");
+  HyperLogLog res;
+  for (size_t i = 0; i < SIZE; ++i)
+    res.registers[i] = std::to_integer<uint8_t>(blob[2 + i]);
+  return res;
+}
+
+TDigest::TDigest(double compression)
+    : compression(compression),
+      min(std::numeric_limits<double>::infinity()),
+      max(-std::numeric_limits<double>::infinity()) {
+  centroids.reserve(2 * static_cast<size_t>(compression));
+  buffer.reserve(4 * static_cast<size_t>(compression));
+}
+
+void TDigest::add(double value, double weight) {
+  if (std::isnan(value) || weight <= 0.0) return;
+  buffer.push_back({value, weight});
+  buffered += weight;
+  min = std::min(min, value);
+  max = std::max(max, value);
+  if (buffer.size() >= 4 * static_cast<size_t>(compression)) compress();
+}
+
+void TDigest::merge(const TDigest& other) {
+  for (const auto& c : other.centroids) add(c.mean, c.weight);
+  for (const auto& c : other.buffer) add(c.mean, c.weight);
+  // Centroid means lie inside the range, keep the exact extremes
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+}
+
+// Neighbour centroids are merged while they fit into a unit of the k1 scale
+// function, so the centroids are small at the tails and large in the middle
+void TDigest::compress() {
+  if (buffer.empty()) return;
+  buffer.insert(buffer.end(), centroids.begin(), centroids.end());
+  std::sort(buffer.begin(), buffer.end(),
+            [](const Centroid& a, const Centroid& b) {
+              return a.mean < b.mean;
+            });
+  total += buffered;
+  buffered = 0.0;
+
+  auto scale = [this](double q) {
+    return compression / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0);
+  };
+
+  centroids.clear();
+  Centroid current = buffer.front();
+  double before = 0.0;
+  double limit = scale(0.0) + 1.0;
+  for (size_t i = 1; i < buffer.size(); ++i) {
+    const auto& next = buffer[i];
+    double q = (before + current.weight + next.weight) / total;
+    if (scale(q) <= limit) {
+      current.weight += next.weight;
+      current.mean += (next.mean - current.mean) * next.weight / current.weight;
+    } else {
+      before += current.weight;
+      centroids.push_back(current);
+      limit = scale(before / total) + 1.0;
+      current = next;
+    }
+  }
+  centroids.push_back(current);
+  buffer.clear();
+}
+
+double TDigest::quantile(double q) const {
+  if (!buffer.empty()) {
+    TDigest copy(*this);
+    copy.compress();
+    return copy.quantile(q);
+  }
+  if (centroids.empty()) return std::numeric_limits<double>::quiet_NaN();
+  q = std::clamp(q, 0.0, 1.0);
+  if (centroids.size() == 1) return centroids.front().mean;
+
+  // Centroid weight is spread evenly around its mean
+  double index = q * total;
+  double before = 0.0;
+  for (size_t i = 0; i < centroids.size(); ++i) {
+    const auto& c = centroids[i];
+    double middle = before + c.weight / 2.0;
+    if (index < middle) {
+      if (i == 0) {
+        double t = c.weight > 1.0 ? index / middle : 1.0;
+        return min + (c.mean - min) * t;
+      }
+      const auto& p = centroids[i - 1];
+      double prevMiddle = before - p.weight / 2.0;
+      double t = (index - prevMiddle) / (middle - prevMiddle);
+      return p.mean + (c.mean - p.mean) * t;
+    }
+    before += c.weight;
+  }
+  const auto& last = centroids.back();
+  double lastMiddle = total - last.weight / 2.0;
+  double t = last.weight > 1.0 ? (index - lastMiddle) / (total - lastMiddle)
+                               : 0.0;
+  return last.mean + (max - last.mean) * std::min(t, 1.0);
+}
+
+Blob TDigest::serialize() const {
+  TDigest copy(*this);
+  copy.compress();
+  Blob res;
+  res.reserve(1 + 8 * (5 + 2 * copy.centroids.size()));
+  res.push_back(TDIGEST_TAG);
+  write(res, copy.compression);
+  write(res, copy.total);
+  write(res, copy.min);
+  write(res, copy.max);
+  write(res, copy.centroids.size());
+  for (const auto& c : copy.centroids) {
+    write(res, c.mean);
+    write(res, c.weight);
+  }
+  return res;
+}
+
+TDigest TDigest::deserialize(const Blob& blob) {
+  checkTag(blob, TDIGEST_TAG, "t-digest");
+  size_t pos = 1;
+  auto compression = read<double>(blob, pos);
+  if (!(compression >= 10.0 && compression <= 10000.0))
+    throw std::runtime_error("Unsupported t-digest compression");
+  TDigest res(compression);
+  res.total = read<double>(blob, pos);
+  res.min = read<double>(blob, pos);
+  res.max = read<double>(blob, pos);
+  auto size = read<size_t>(blob, pos);
+  if (size > (blob.size() - pos) / 16)
+    throw std::runtime_error("Truncated sketch");
+  for (size_t i = 0; i < size; ++i) {
+    auto mean = read<double>(blob, pos);
+    auto weight = read<double>(blob, pos);
+    res.centroids.push_back({mean, weight});
+  }
+  return res;
+}
+
+TopK::TopK(size_t capacity) : capacity(capacity) {
+  items.reserve(capacity);
+  index.reserve(capacity);
+}
+
+void TopK::add(const std::string& value, uint64_t count) {
+  add(value, count, 0);
+}
+
+void TopK::add(const std::string& value, uint64_t count, uint64_t error) {
+  auto it = index.find(value);
+  if (it != index.end()) {
+    items[it->second].count += count;
+    items[it->second].error += error;
+    return;
+  }
+  if (items.size() < capacity) {
+    index.emplace(value, items.size());
+    items.push_back({value, count, error});
+    return;
+  }
+  // The least frequent item is replaced, its count bounds the new item error
+  auto least = std::min_element(
+      items.begin(), items.end(),
+      [](const Item& a, const Item& b) { return a.count < b.count; });
+  index.erase(least->value);
+  index.emplace(value, least - items.begin());
+  least->error = least->count + error;
+  least->count += count;
+  least->value = value;
+}
+
+void TopK::merge(const TopK& other) {
+  for (const auto& i : other.items) add(i.value, i.count, i.error);
+}
+
+std::vector<TopK::Item> TopK::top(size_t k) const {
+  auto res = items;
+  std::sort(res.begin(), res.end(), [](const Item& a, const Item& b) {
+    return a.count > b.count || (a.count == b.count && a.value < b.value);
+  });
+  if (res.size() > k) res.resize(k);
+  return res;
+}
+
+std::string TopK::topJson(size_t k) const {
+  std::string res = "[";
+  for (const auto& i : top(k)) {
+    if (res.size() > 1) res += ",";
+    res += "{\"value\":";
+    appendJson(res, i.value);
+    res += ",\"count\":";
+    appendJson(res, static_cast<Integer>(i.count));
+    res += "}";
+  }
+  res += "]";
+  return res;
+}
+
+Blob TopK::serialize() const {
+  Blob res;
+  res.push_back(TOPK_TAG);
+  write(res, capacity);
+  write(res, items.size());
+  for (const auto& i : items) {
+    write(res, i.count);
+    write(res, i.error);
+    write(res, i.value.size());
+    auto ptr = reinterpret_cast<const std::byte*>(i.value.data());
+    res.insert(res.end(), ptr, ptr + i.value.size());
+  }
+  return res;
+}
+
+TopK TopK::deserialize(const Blob& blob) {
+  checkTag(blob, TOPK_TAG, "top-k");
+  size_t pos = 1;
+  auto capacity = read<size_t>(blob, pos);
+  auto size = read<size_t>(blob, pos);
+  if (capacity == 0 || capacity > 65536 || size > capacity)
+    throw std::runtime_error("Unsupported top-k sketch");
+  TopK res(capacity);
+  for (size_t i = 0; i < size; ++i) {
+    auto count = read<uint64_t>(blob, pos);
+    auto error = read<uint64_t>(blob, pos);
+    auto length = read<size_t>(blob, pos);
+    if (length > blob.size() - pos)
+      throw std::runtime_error("Truncated sketch");
+    std::string value(reinterpret_cast<const char*>(blob.data() + pos), length);
+    pos += length;
+    res.add(value, count, error);
+  }
+  return res;
+}
+
+}  // namespace sketch
+
+namespace {
+
+struct Quantile {
+  sketch::TDigest digest;
+  double q = 0.5;
+};
+
+struct Heavy {
+  sketch::TopK summary;
+  Integer k = 0;
+};
+
+}  // namespace
+
+void registerSketches(const Database& db) {
+  using namespace sketch;
+
+  auto addValue = [](HyperLogLog& s, const Text& v) { s.add(v); };
+  auto mergeHll = [](HyperLogLog& s, const Blob& b) {
+    s.merge(HyperLogLog::deserialize(b));
+  };
+  auto hllCount = [](const HyperLogLog& s) {
+    return static_cast<Integer>(std::llround(s.estimate()));
+  };
+  auto hllBlob = [](const HyperLogLog& s) { return s.serialize(); };
+  db.registerAggregate<HyperLogLog>("approx_count_distinct", addValue,
+                                    hllCount, true);
+  db.registerAggregate<HyperLogLog>("hll_sketch", addValue, hllBlob, true);
+  db.registerAggregate<HyperLogLog>("hll_merge", mergeHll, hllBlob, true);
+  db.registerFunction(
+      "hll_estimate",
+      [hllCount](const Blob& b) {
+        return hllCount(HyperLogLog::deserialize(b));
+      },
+      true);
+
+  auto addNumber = [](TDigest& s, Real v) { s.add(v); };
+  auto mergeDigest = [](TDigest& s, const Blob& b) {
+    s.merge(TDigest::deserialize(b));
+  };
+  auto digestBlob = [](const TDigest& s) { return s.serialize(); };
+  db.registerAggregate<Quantile>(
+      "approx_quantile",
+      [](Quantile& s, Real v, Real q) {
+        s.digest.add(v);
+        s.q = q;
+      },
+      [](const Quantile& s) { return s.digest.quantile(s.q); }, true);
+  db.registerAggregate<TDigest>("tdigest_sketch", addNumber, digestBlob,
+                                true);
+  db.registerAggregate<TDigest>("tdigest_merge", mergeDigest, digestBlob,
+                                true);
+  db.registerFunction(
+      "tdigest_quantile",
+      [](const Blob& b, Real q) { return TDigest::deserialize(b).quantile(q); },
+      true);
+
+  auto addItem = [](TopK& s, const Text& v) { s.add(v); };
+  auto mergeTopK = [](TopK& s, const Blob& b) {
+    s.merge(TopK::deserialize(b));
+  };
+  auto topKBlob = [](const TopK& s) { return s.serialize(); };
+  db.registerAggregate<Heavy>(
+      "approx_top_k",
+      [](Heavy& s, const Text& v, Integer k) {
+        s.summary.add(v);
+        s.k = k;
+      },
+      [](const Heavy& s) { return s.summary.topJson(s.k); }, true);
+  db.registerAggregate<TopK>("topk_sketch", addItem, topKBlob, true);
+  db.registerAggregate<TopK>("topk_merge", mergeTopK, topKBlob, true);
+  db.registerFunction(
+      "topk_items",
+      [](const Blob& b, Integer k) { return TopK::deserialize(b).topJson(k); },
+      true);
+}
+
+}  // namespace sqlpp
@@ -0,0 +1,197 @@
+#ifndef SQLPP_SKETCH_H_
+#define SQLPP_SKETCH_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "function.h"
+
+namespace sqlpp {
+
+namespace sketch {
+
+uint64_t hash(const std::string& value);
+
+// Distinct count estimate with 2^PRECISION one byte registers, the relative
+// error is about 1.6%
+class HyperLogLog {
+ public:
+  static constexpr unsigned PRECISION = 12;
+  static constexpr size_t SIZE = size_t(1) << PRECISION;
+
+  HyperLogLog();
+
+  void add(const std::string& value);
+  void merge(const HyperLogLog& other);
+
+  double estimate() const;
+
+  Blob serialize() const;
+  static HyperLogLog deserialize(const Blob& blob);
+
+ private:
+  std::vector<uint8_t> registers;
+};
+
+// Merging t-digest, the number of centroids is bounded by the compression
+class TDigest {
+ public:
+  explicit TDigest(double compression = 100.0);
+
+  void add(double value, double weight = 1.0);
+  void merge(const TDigest& other);
+
+  double count() const { return total + buffered; }
+  // NaN for an empty digest, SQLite turns it into NULL
+  double quantile(double q) const;
+
+  Blob serialize() const;
+  static TDigest deserialize(const Blob& blob);
+
+ private:
+  struct Centroid {
+    double mean;
+    double weight;
+  };
+
+  void compress();
+
+  double compression;
+  std::vector<Centroid> centroids;
+  std::vector<Centroid> buffer;
+  double total = 0.0;
+  double buffered = 0.0;
+  double min;
+  double max;
+};
+
+// Space-Saving heavy hitters summary with a fixed number of counters. The
+// count of an item is overestimated by at most its error.
+class TopK {
+ public:
+  struct Item {
+    std::string value;
+    uint64_t count;
+    uint64_t error;
+  };
+
+  explicit TopK(size_t capacity = 64);
+
+  void add(const std::string& value, uint64_t count = 1);
+  void merge(const TopK& other);
+
+  std::vector<Item> top(size_t k) const;
+  // JSON array of {"value": ..., "count": ...} objects for json_each()
+  std::string topJson(size_t k) const;
+
+  Blob serialize() const;
+  static TopK deserialize(const Blob& blob);
+
+ private:
+  void add(const std::string& value, uint64_t count, uint64_t error);
+
+  size_t capacity;
+  std::vector<Item> items;
+  std::unordered_map<std::string, size_t> index;
+};
+
+}  // namespace sketch
+
+// Registers the sketch aggregates and functions below in the database:
+//   approx_count_distinct(x), hll_sketch(x), hll_merge(s), hll_estimate(s)
+//   approx_quantile(x, q), tdigest_sketch(x), tdigest_merge(s),
+//   tdigest_quantile(s, q)
+//   approx_top_k(x, k), topk_sketch(x), topk_merge(s), topk_items(s, k)
+// Sketches are BLOBs, so they may be stored per group and merged later.
+void registerSketches(const Database& db);
+
+template <typename E, typename V>
+using SketchResult = expr::Expression<expr::ExprTables<expr::AnyExpr, E>, V>;
+
+template <typename E>
+SketchResult<E, Integer> approxCountDistinct(E&& e) {
+  return SketchResult<E, Integer>("approx_count_distinct", false,
+                                  std::forward<E>(e));
+}
+
+template <typename E>
+SketchResult<E, Blob> hllSketch(E&& e) {
+  return SketchResult<E, Blob>("hll_sketch", false, std::forward<E>(e));
+}
+
+template <typename E>
+SketchResult<E, Blob> hllMerge(E&& sketch) {
+  static_assert(std::is_same_v<expr::ExprTerm<expr::AnyExpr, E>, Blob>,
+                "Sketch must be a BLOB");
+  return SketchResult<E, Blob>("hll_merge", false, std::forward<E>(sketch));
+}
+
+template <typename E>
+SketchResult<E, Integer> hllEstimate(E&& sketch) {
+  static_assert(std::is_same_v<expr::ExprTerm<expr::AnyExpr, E>, Blob>,
+                "Sketch must be a BLOB");
+  return SketchResult<E, Integer>("hll_estimate", false,
+                                  std::forward<E>(sketch));
+}
+
+template <typename E>
+expr::Expression<expr::ExprTables<expr::NumExpr, E>, Real> approxQuantile(
+    E&& e, Real q) {
+  return expr::Expression<expr::ExprTables<expr::NumExpr, E>, Real>(
+      "approx_quantile", false, std::forward<E>(e), expr::Literal<Real>(q));
+}
+
+template <typename E>
+expr::Expression<expr::ExprTables<expr::NumExpr, E>, Blob> tdigestSketch(
+    E&& e) {
+  return expr::Expression<expr::ExprTables<expr::NumExpr, E>, Blob>(
+      "tdigest_sketch", false, std::forward<E>(e));
+}
+
+template <typename E>
+SketchResult<E, Blob> tdigestMerge(E&& sketch) {
+  static_assert(std::is_same_v<expr::ExprTerm<expr::AnyExpr, E>, Blob>,
+                "Sketch must be a BLOB");
+  return SketchResult<E, Blob>("tdigest_merge", false,
+                               std::forward<E>(sketch));
+}
+
+template <typename E>
+SketchResult<E, Real> tdigestQuantile(E&& sketch, Real q) {
+  static_assert(std::is_same_v<expr::ExprTerm<expr::AnyExpr, E>, Blob>,
+                "Sketch must be a BLOB");
+  return SketchResult<E, Real>("tdigest_quantile", false,
+                               std::forward<E>(sketch), expr::Literal<Real>(q));
+}
+
+template <typename E>
+SketchResult<E, Text> approxTopK(E&& e, Integer k) {
+  return SketchResult<E, Text>("approx_top_k", false, std::forward<E>(e),
+                               expr::Literal<Integer>(k));
+}
+
+template <typename E>
+SketchResult<E, Blob> topKSketch(E&& e) {
+  return SketchResult<E, Blob>("topk_sketch", false, std::forward<E>(e));
+}
+
+template <typename E>
+SketchResult<E, Blob> topKMerge(E&& sketch) {
+  static_assert(std::is_same_v<expr::ExprTerm<expr::AnyExpr, E>, Blob>,
+                "Sketch must be a BLOB");
+  return SketchResult<E, Blob>("topk_merge", false, std::forward<E>(sketch));
+}
+
+template <typename E>
+SketchResult<E, Text> topKItems(E&& sketch, Integer k) {
+  static_assert(std::is_same_v<expr::ExprTerm<expr::AnyExpr, E>, Blob>,
+                "Sketch must be a BLOB");
+  return SketchResult<E, Text>("topk_items", false, std::forward<E>(sketch),
+                               expr::Literal<Integer>(k));
+}
+
+}  // namespace sqlpp
+
+#endif /* SQLPP_SKETCH_H_ */
@@ -1,7 +1,12 @@
 #ifndef SQLPP_STATEMENT_H_
 #define SQLPP_STATEMENT_H_
 
+#include "expr/aggregate.h"
+#include "expr/scalar.h"
+#include "expr/subquery.h"
+#include "expr/window.h"
 #include "stmt/create.h"
+#include "stmt/delete.h"
 #include "stmt/insert.h"
 #include "stmt/select.h"
 #include "stmt/update.h"
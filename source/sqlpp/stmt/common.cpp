@@ -1,5 +1,7 @@
 #include "common.h"
 
+#include "../database.h"
+
 namespace sqlpp {
 
 Statement::Statement() = default;
@@ -9,4 +11,8 @@ Statement::~Statement() = default;
 Statement& Statement::operator=(const Statement&) = default;
 Statement& Statement::operator=(Statement&&) = default;
 
+Plan Statement::explain(const Database& db) const {
+  return Plan(run(db, "EXPLAIN QUERY PLAN "));
+}
+
 }  // namespace sqlpp
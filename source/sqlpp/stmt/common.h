@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "../plan.h"
 #include "../result.h"
 #include "../table.h"
 
@@ -27,6 +28,13 @@ class Statement {
 
   virtual void dump(std::ostream& stream) const = 0;
   virtual Result execute(const Database& db) const = 0;
+
+  // Runs EXPLAIN QUERY PLAN for the statement with its binds
+  Plan explain(const Database& db) const;
+
+ protected:
+  // Executes the statement SQL preceded by the prefix
+  virtual Result run(const Database& db, const std::string& prefix) const = 0;
 };
 
 inline std::ostream& operator<<(std::ostream& stream, const Statement& stmt) {
@@ -54,9 +62,35 @@ class StatementD : public Statement {
   Result execute(const Database& db) const override { return data.execute(db); }
 
  protected:
+  Result run(const Database& db, const std::string& prefix) const override {
+    return data.execute(db, prefix);
+  }
+
   D data;
 };
 
+template <typename R>
+struct ResultS : ResultS<typename R::ExpressionType> {};
+
+template <typename R>
+requires requires { typename R::TableType; }
+struct ResultS<R> {
+  using Tables = types::MakeList<TableType<R>>;
+  using Values = ValueType<R>;
+};
+
+template <typename T, typename V>
+struct ResultS<expr::Expression<T, V>> {
+  using Tables = T;
+  using Values = types::MakeList<V>;
+};
+
+template <typename R>
+using ResultTables = typename ResultS<std::remove_cvref_t<R>>::Tables;
+
+template <typename R>
+using ResultValues = typename ResultS<std::remove_cvref_t<R>>::Values;
+
 }  // namespace stmt
 }  // namespace sqlpp
 
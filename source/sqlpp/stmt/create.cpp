@@ -14,9 +14,19 @@ CreateTableData::CreateTableData(CreateTableData&&) = default;
 CreateTableData& CreateTableData::operator=(CreateTableData const&) = default;
 CreateTableData& CreateTableData::operator=(CreateTableData&&) = default;
 
-void CreateTableData::addColumnDesc(const std::string& name,
-                                    const std::string& type) {
-  columnDesc.emplace_back(name, type);
+void CreateTableData::addColumnDesc(
+    const std::string& name, const std::string& type, bool notNull,
+    const std::optional<std::string>& defaultValue) {
+  columnDesc.emplace_back(name, type, notNull, defaultValue);
+}
+
+void CreateTableData::addPrimaryKey(const std::string& name) {
+  primaryKey.push_back(name);
+}
+
+void CreateTableData::setOptions(bool withoutRowid, bool strict) {
+  this->withoutRowid = withoutRowid;
+  this->strict = strict;
 }
 
 void CreateTableData::dump(std::ostream& stream) const {
@@ -28,18 +38,43 @@ void CreateTableData::dump(std::ostream& stream) const {
     if (!first) stream << ", ";
     first = false;
     stream << c.name << " " << c.type;
+    // Single-column key is declared inline, so INTEGER key becomes rowid alias
+    if (primaryKey.size() == 1 && primaryKey.front() == c.name)
+      stream << " PRIMARY KEY";
+    if (c.notNull) stream << " NOT NULL";
+    if (c.defaultValue) stream << " DEFAULT " << *c.defaultValue;
+  }
+  if (primaryKey.size() > 1) {
+    stream << ", PRIMARY KEY (";
+    first = true;
+    for (auto&& k : primaryKey) {
+      if (!first) stream << ", ";
+      first = false;
+      stream << k;
+    }
+    stream << ")";
   }
   stream << ")";
+
+  if (withoutRowid) stream << " WITHOUT ROWID";
+  if (withoutRowid && strict) stream << ",";
+  if (strict) stream << " STRICT";
 }
 
-Result CreateTableData::execute(const Database& db) const {
+Result CreateTableData::execute(const Database& db,
+                                const std::string& prefix) const {
   std::ostringstream ss;
-  dump(ss);
+  {
+    SQLPP_TIME(RENDER);
+    ss << prefix;
+    dump(ss);
+  }
   return db.execute(ss.str());
 }
 
-CreateTableData::ColumnDesc::ColumnDesc(const std::string& name,
-                                        const std::string& type)
-    : name(name), type(type) {}
+CreateTableData::ColumnDesc::ColumnDesc(
+    const std::string& name, const std::string& type, bool notNull,
+    const std::optional<std::string>& defaultValue)
+    : name(name), type(type), notNull(notNull), defaultValue(defaultValue) {}
 
 }  // namespace sqlpp::stmt
@@ -16,22 +16,32 @@ class CreateTableData {
   CreateTableData& operator=(const CreateTableData&);
   CreateTableData& operator=(CreateTableData&&);
 
-  void addColumnDesc(const std::string& name, const std::string& type);
+  void addColumnDesc(const std::string& name, const std::string& type,
+                     bool notNull = false,
+                     const std::optional<std::string>& defaultValue = {});
+  void addPrimaryKey(const std::string& name);
+  void setOptions(bool withoutRowid, bool strict);
 
   void dump(std::ostream& stream) const;
-  Result execute(const Database& db) const;
+  Result execute(const Database& db, const std::string& prefix = "") const;
 
  private:
   struct ColumnDesc {
     std::string name;
     std::string type;
+    bool notNull;
+    std::optional<std::string> defaultValue;
 
-    ColumnDesc(const std::string& name, const std::string& type);
+    ColumnDesc(const std::string& name, const std::string& type, bool notNull,
+               const std::optional<std::string>& defaultValue);
   };
 
   std::string tableName;
   bool ifNotExists;
+  bool withoutRowid = false;
+  bool strict = false;
   std::vector<ColumnDesc> columnDesc;
+  std::vector<std::string> primaryKey;
 };
 
 template <typename T, typename... V>
@@ -40,7 +50,11 @@ class CreateTable final : public StatementD<CreateTableData> {
   using StatementD::StatementD;
   CreateTable(const Table<T, V...>& table, bool ifNotExists)
       : StatementD(table.getName(), ifNotExists) {
+    static_assert(!T::WITHOUT_ROWID || PrimaryKeyType<T>::SIZE > 0,
+                  "WITHOUT ROWID table must have a primary key");
     insertColumns(table);
+    insertPrimaryKey(table, PrimaryKeyType<T>());
+    data.setOptions(T::WITHOUT_ROWID, T::STRICT);
   }
 
  public:
@@ -56,10 +70,18 @@ class CreateTable final : public StatementD<CreateTableData> {
   void insertColumns(const Table<T, V...>& table) {
     data.addColumnDesc(
         table.getColumnName(N),
-        TypeName<types::Get<N, typename Table<T, V...>::Row>>::get());
+        TypeName<types::Get<N, typename Table<T, V...>::Row>>::get(),
+        table.isNotNull(N), table.getDefault(N));
     if constexpr (N + 1 < Table<T, V...>::COLUMN_COUNT)
       insertColumns<N + 1>(table);
   }
+
+  template <size_t... I>
+  void insertPrimaryKey(const Table<T, V...>& table, PrimaryKey<I...>) {
+    static_assert(((I < Table<T, V...>::COLUMN_COUNT) && ...),
+                  "Primary key column index is out of range");
+    (data.addPrimaryKey(table.getColumnName(I)), ...);
+  }
 };
 
 }  // namespace stmt
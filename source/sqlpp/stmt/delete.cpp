@@ -0,0 +1,150 @@
+#include "delete.h"
+
+#include <sqlite3.h>
+
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "../database.h"
+
+namespace sqlpp::stmt {
+
+DeleteData::DeleteData(const std::string& tableName) : tableName(tableName) {}
+
+DeleteData::DeleteData(const DeleteData& other)
+    : tableName(other.tableName),
+      keys(other.keys),
+      binds(other.binds),
+      returning(other.returning) {
+  if (other.root) root = other.root->clone();
+}
+
+DeleteData::DeleteData(DeleteData&&) = default;
+
+DeleteData& DeleteData::operator=(const DeleteData& other) {
+  if (this != &other) *this = DeleteData(other);
+  return *this;
+}
+
+DeleteData& DeleteData::operator=(DeleteData&&) = default;
+
+void DeleteData::addKey(const std::string& name) { keys.push_back(name); }
+
+void DeleteData::addCondition(expr::Data&& cond) {
+  binds.insert(binds.end(), make_move_iterator(cond.binds.begin()),
+               make_move_iterator(cond.binds.end()));
+  root = move(cond.root);
+}
+
+void DeleteData::dump(std::ostream& stream) const {
+  stream << "DELETE FROM " << tableName;
+  if (root) {
+    stream << " WHERE ";
+    root->dump(stream);
+  }
+  returning.dump(stream);
+}
+
+Result DeleteData::execute(const Database& db,
+                           const std::string& prefix) const {
+  std::ostringstream ss;
+  {
+    SQLPP_TIME(RENDER);
+    ss << prefix;
+    dump(ss);
+  }
+  if (!returning.hasBinds()) return db.execute(ss.str(), binds);
+  auto allBinds = binds;
+  returning.appendBinds(allBinds);
+  return db.execute(ss.str(), allBinds);
+}
+
+// DELETE ... LIMIT needs a custom SQLite build, so a chunk is selected by the
+// row keys instead
+void DeleteData::dumpChunk(std::ostream& stream, size_t chunkSize) const {
+  std::ostringstream keyStream;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (i != 0) keyStream << ", ";
+    keyStream << keys[i];
+  }
+  auto keyList = keyStream.str();
+  if (keys.size() > 1) keyList = "(" + keyList + ")";
+
+  stream << "DELETE FROM " << tableName << " WHERE " << keyList
+         << " IN (SELECT " << keyStream.str() << " FROM " << tableName;
+  if (root) {
+    stream << " WHERE ";
+    root->dump(stream);
+  }
+  stream << " LIMIT " << chunkSize << ")";
+}
+
+// Another connection holding the write lock makes a chunk fail with
+// SQLITE_BUSY, such a chunk is retried with an exponential backoff
+static constexpr int PURGE_BUSY_RETRIES = 10;
+static constexpr std::chrono::milliseconds PURGE_FIRST_BACKOFF(1);
+
+// Pause after each committed chunk, so waiting writers can take the lock
+static constexpr std::chrono::milliseconds PURGE_CHUNK_PAUSE(1);
+
+enum class ChunkStatus { DONE, BUSY, FAILED };
+
+static ChunkStatus failChunk(const Database& db, const std::string& what,
+                             bool rollback, std::string& error) {
+  bool busy = (sqlite3_extended_errcode(db.handle()) & 0xFF) == SQLITE_BUSY;
+  error = what + ": " + sqlite3_errmsg(db.handle());
+  if (rollback) db.execute("ROLLBACK");
+  return busy ? ChunkStatus::BUSY : ChunkStatus::FAILED;
+}
+
+PurgeProgress DeleteData::purge(const Database& db, size_t chunkSize,
+                                const PurgeCallback& callback) const {
+  if (chunkSize == 0) throw std::runtime_error("Purge chunk size is zero");
+  if (!sqlite3_get_autocommit(db.handle()))
+    throw std::runtime_error("Purge cannot run inside a transaction");
+
+  std::ostringstream ss;
+  dumpChunk(ss, chunkSize);
+  auto sql = ss.str();
+
+  auto deleteChunk = [&](size_t& removed, std::string& error) {
+    if (!db.execute("BEGIN IMMEDIATE"))
+      return failChunk(db, "Cannot start purge of " + tableName, false, error);
+    {
+      auto res = db.execute(sql, binds);
+      if (!res) return failChunk(db, "Cannot purge " + tableName, true, error);
+      removed = sqlite3_changes64(db.handle());
+    }
+    if (!db.execute("COMMIT"))
+      return failChunk(db, "Cannot commit purge of " + tableName, true,
+                       error);
+    return ChunkStatus::DONE;
+  };
+
+  PurgeProgress progress;
+  for (;;) {
+    size_t removed = 0;
+    std::string error;
+    auto backoff = PURGE_FIRST_BACKOFF;
+    for (int retry = 0;; ++retry) {
+      auto status = deleteChunk(removed, error);
+      if (status == ChunkStatus::DONE) break;
+      if (status == ChunkStatus::FAILED || retry == PURGE_BUSY_RETRIES)
+        throw std::runtime_error(error);
+      std::this_thread::sleep_for(backoff);
+      backoff *= 2;
+    }
+
+    ++progress.chunks;
+    progress.rows += removed;
+    if (callback && !callback(progress)) break;
+    if (removed < chunkSize) break;
+
+    std::this_thread::sleep_for(PURGE_CHUNK_PAUSE);
+  }
+  return progress;
+}
+
+}  // namespace sqlpp::stmt
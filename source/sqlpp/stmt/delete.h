@@ -0,0 +1,137 @@
+#ifndef SRC_SQLPP_STMT_DELETE_H_
+#define SRC_SQLPP_STMT_DELETE_H_
+
+#include <functional>
+
+#include "../expr/condition.h"
+#include "../expr/node.h"
+#include "returning.h"
+
+namespace sqlpp {
+namespace stmt {
+
+struct PurgeProgress {
+  size_t chunks = 0;
+  size_t rows = 0;
+};
+
+// Called after every committed chunk; returning false stops the purge
+using PurgeCallback = std::function<bool(const PurgeProgress&)>;
+
+class DeleteData {
+ public:
+  explicit DeleteData(const std::string& tableName);
+
+  DeleteData(const DeleteData&);
+  DeleteData(DeleteData&&);
+
+  DeleteData& operator=(const DeleteData&);
+  DeleteData& operator=(DeleteData&&);
+
+  void addKey(const std::string& name);
+
+  void addCondition(expr::Data&& cond);
+
+  void dump(std::ostream& stream) const;
+  Result execute(const Database& db, const std::string& prefix = "") const;
+
+  PurgeProgress purge(const Database& db, size_t chunkSize,
+                      const PurgeCallback& callback) const;
+
+ private:
+  void dumpChunk(std::ostream& stream, size_t chunkSize) const;
+
+  std::string tableName;
+  std::vector<std::string> keys;
+  std::vector<Bind> binds;
+  expr::Node::Ptr root;
+  ReturningData returning;
+
+  template <typename A, typename B>
+  friend class ReturningStatement;
+};
+
+template <typename T, typename C>
+class DeleteWhere;
+
+template <typename T>
+class Delete final : public ReturningStatement<DeleteData, T> {
+ private:
+  using ReturningStatement<DeleteData, T>::ReturningStatement;
+
+  explicit Delete(const T& table)
+      : ReturningStatement<DeleteData, T>(table.getName()) {
+    if constexpr (T::WITHOUT_ROWID)
+      addKeys(table, PrimaryKeyType<T>());
+    else
+      this->data.addKey("rowid");
+  }
+
+ public:
+  static Delete<T> make(const T& table) { return Delete<T>(table); }
+
+  ~Delete() override = default;
+
+  template <typename C>
+  DeleteWhere<T, expr::ExprTables<expr::BoolExpr, C>> where(
+      C&& condition) const& {
+    return DeleteWhere<T, expr::ExprTables<expr::BoolExpr, C>>(
+        DeleteData(this->data), std::forward<C>(condition));
+  }
+
+  template <typename C>
+  DeleteWhere<T, expr::ExprTables<expr::BoolExpr, C>> where(C&& condition) && {
+    return DeleteWhere<T, expr::ExprTables<expr::BoolExpr, C>>(
+        std::move(this->data), std::forward<C>(condition));
+  }
+
+  // Deletes the rows in transactions of at most chunkSize rows each, so
+  // other writers are not locked out until the whole purge is finished. A
+  // chunk that finds the database locked is retried with a backoff.
+  PurgeProgress purge(const Database& db, size_t chunkSize,
+                      const PurgeCallback& callback = {}) const {
+    return this->data.purge(db, chunkSize, callback);
+  }
+
+ private:
+  template <size_t... I>
+  void addKeys(const T& table, PrimaryKey<I...>) {
+    (this->data.addKey(table.getColumnName(I)), ...);
+  }
+};
+
+template <typename T, typename C>
+class DeleteWhere final : public ReturningStatement<DeleteData, T> {
+  friend class Delete<T>;
+
+  static_assert(types::Contains<C, types::MakeList<TableType<T>>>,
+                "Condition may refer only to the table to delete from");
+
+ private:
+  using ReturningStatement<DeleteData, T>::ReturningStatement;
+
+  DeleteWhere(DeleteData&& data, expr::Condition<C>&& condition)
+      : ReturningStatement<DeleteData, T>(std::move(data)) {
+    this->data.addCondition(std::move(condition.data));
+  }
+
+ public:
+  ~DeleteWhere() override = default;
+
+  // See Delete::purge()
+  PurgeProgress purge(const Database& db, size_t chunkSize,
+                      const PurgeCallback& callback = {}) const {
+    return this->data.purge(db, chunkSize, callback);
+  }
+};
+
+}  // namespace stmt
+
+template <typename T>
+inline stmt::Delete<TableType<T>> deleteFrom(const T& table) {
+  return stmt::Delete<TableType<T>>::make(table);
+}
+
+}  // namespace sqlpp
+
+#endif /* SRC_SQLPP_STMT_DELETE_H_ */
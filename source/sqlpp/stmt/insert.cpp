@@ -8,9 +8,27 @@ namespace sqlpp::stmt {
 
 InsertData::InsertData(const std::string& tableName) : tableName(tableName) {}
 
-InsertData::InsertData(const InsertData&) = default;
+InsertData::InsertData(const InsertData& other)
+    : tableName(other.tableName),
+      names(other.names),
+      binds(other.binds),
+      select(other.select),
+      conflict(other.conflict),
+      conflictColumns(other.conflictColumns),
+      conflictBinds(other.conflictBinds),
+      returning(other.returning) {
+  for (const auto& a : other.conflictAssignments)
+    conflictAssignments.emplace_back(get<0>(a), get<1>(a)->clone());
+  if (other.conflictRoot) conflictRoot = other.conflictRoot->clone();
+}
+
 InsertData::InsertData(InsertData&&) = default;
-InsertData& InsertData::operator=(const InsertData&) = default;
+
+InsertData& InsertData::operator=(const InsertData& other) {
+  if (this != &other) *this = InsertData(other);
+  return *this;
+}
+
 InsertData& InsertData::operator=(InsertData&&) = default;
 
 void InsertData::addValue(const std::string& name, Bind bind) {
@@ -20,9 +38,42 @@ void InsertData::addValue(const std::string& name, Bind bind) {
 
 void InsertData::addValue(Bind bind) { binds.emplace_back(move(bind)); }
 
+void InsertData::setSelect(const SelectData& source) {
+  std::ostringstream ss;
+  source.dump(ss);
+  select = ss.str();
+  binds = source.binds;
+}
+
+void InsertData::setConflict() { conflict = true; }
+
+void InsertData::addConflictColumn(const std::string& name) {
+  conflictColumns.emplace_back(name);
+}
+
+void InsertData::addConflictAssignment(const std::string& column,
+                                       expr::Data&& data) {
+  conflictAssignments.emplace_back(column, move(data.root));
+  conflictBinds.insert(conflictBinds.end(),
+                       make_move_iterator(data.binds.begin()),
+                       make_move_iterator(data.binds.end()));
+}
+
+void InsertData::addConflictCondition(expr::Data&& cond) {
+  conflictBinds.insert(conflictBinds.end(),
+                       make_move_iterator(cond.binds.begin()),
+                       make_move_iterator(cond.binds.end()));
+  conflictRoot = move(cond.root);
+}
+
 void InsertData::dump(std::ostream& stream) const {
   stream << "INSERT INTO " << tableName;
-  if (binds.empty()) {
+  if (!select.empty() && conflict) {
+    // ON after a bare FROM would be parsed as a join constraint
+    stream << " SELECT * FROM (" << select << ") WHERE true";
+  } else if (!select.empty()) {
+    stream << " " << select;
+  } else if (binds.empty()) {
     stream << " DEFAULT VALUES";
   } else if (names.empty()) {
     stream << " VALUES (";
@@ -46,12 +97,51 @@ void InsertData::dump(std::ostream& stream) const {
     }
     stream << ") VALUES (" << valStream.str() << ")";
   }
+
+  if (conflict) {
+    stream << " ON CONFLICT";
+    if (!conflictColumns.empty()) {
+      stream << " (";
+      for (size_t i = 0; i < conflictColumns.size(); ++i) {
+        if (i != 0) stream << ", ";
+        stream << conflictColumns[i];
+      }
+      stream << ")";
+    }
+    if (conflictAssignments.empty()) {
+      stream << " DO NOTHING";
+    } else {
+      stream << " DO UPDATE SET ";
+      bool first = true;
+      for (const auto& a : conflictAssignments) {
+        if (!first) stream << ", ";
+        first = false;
+        stream << get<0>(a) << " = ";
+        get<1>(a)->dump(stream);
+      }
+      if (conflictRoot) {
+        stream << " WHERE ";
+        conflictRoot->dump(stream);
+      }
+    }
+  }
+  returning.dump(stream);
 }
 
-Result InsertData::execute(const Database& db) const {
+Result InsertData::execute(const Database& db,
+                           const std::string& prefix) const {
   std::ostringstream ss;
-  dump(ss);
-  return db.execute(ss.str(), binds);
+  {
+    SQLPP_TIME(RENDER);
+    ss << prefix;
+    dump(ss);
+  }
+  if (conflictBinds.empty() && !returning.hasBinds())
+    return db.execute(ss.str(), binds);
+  auto allBinds = binds;
+  allBinds.insert(allBinds.end(), conflictBinds.begin(), conflictBinds.end());
+  returning.appendBinds(allBinds);
+  return db.execute(ss.str(), allBinds);
 }
 
 }  // namespace sqlpp::stmt
\ No newline at end of file
@@ -1,7 +1,10 @@
 #ifndef SRC_SQLPP_STMT_INSERT_H_
 #define SRC_SQLPP_STMT_INSERT_H_
 
-#include "common.h"
+#include "../expr/condition.h"
+#include "../expr/node.h"
+#include "returning.h"
+#include "select.h"
 
 namespace sqlpp {
 namespace stmt {
@@ -19,23 +22,56 @@ class InsertData {
   void addValue(const std::string& name, Bind bind);
   void addValue(Bind bind);
 
+  void setSelect(const SelectData& select);
+
+  void setConflict();
+  void addConflictColumn(const std::string& name);
+  void addConflictAssignment(const std::string& column, expr::Data&& data);
+  void addConflictCondition(expr::Data&& cond);
+
   void dump(std::ostream& stream) const;
-  Result execute(const Database& db) const;
+  Result execute(const Database& db, const std::string& prefix = "") const;
 
  private:
   std::string tableName;
   std::vector<std::string> names;
   std::vector<Bind> binds;
+  std::string select;
+  bool conflict = false;
+  std::vector<std::string> conflictColumns;
+  std::vector<std::tuple<std::string, expr::Node::Ptr>> conflictAssignments;
+  expr::Node::Ptr conflictRoot;
+  std::vector<Bind> conflictBinds;
+  ReturningData returning;
+
+  template <typename A, typename B>
+  friend class ReturningStatement;
 };
 
 template <typename T>
 class InsertRow;
 
 template <typename T>
-class Insert final : public StatementD<InsertData> {
+class InsertValues;
+
+template <typename T>
+class InsertSelect;
+
+template <typename T>
+class InsertConflict;
+
+template <typename T>
+class Upsert;
+
+template <typename T>
+class UpsertUpdate;
+
+template <typename T>
+class Insert final : public ReturningStatement<InsertData, T> {
  private:
-  using StatementD::StatementD;
-  explicit Insert(const std::string& tableName) : StatementD(tableName) {}
+  using ReturningStatement<InsertData, T>::ReturningStatement;
+  explicit Insert(const std::string& tableName)
+      : ReturningStatement<InsertData, T>(tableName) {}
 
  public:
   static Insert<T> make(const T& table) { return Insert<T>(table.getName()); }
@@ -44,30 +80,75 @@ class Insert final : public StatementD<InsertData> {
 
   template <typename V, typename... VV>
   InsertRow<T> values(V&& value, VV&&... values) const& {
-    return InsertRow<T>(data, std::forward<V>(value),
+    return InsertRow<T>(this->data, std::forward<V>(value),
                         std::forward<VV>(values)...);
   }
 
   template <typename V, typename... VV>
   InsertRow<T> values(V&& value, VV&&... values) && {
-    return InsertRow<T>(std::move(data), std::forward<V>(value),
+    return InsertRow<T>(std::move(this->data), std::forward<V>(value),
                         std::forward<VV>(values)...);
   }
+
+  // Rows are copied by SQLite itself, they are never decoded into C++ values
+  template <typename S>
+  InsertSelect<T> from(const S& select) const& {
+    return addSelect(InsertData(this->data), select);
+  }
+
+  template <typename S>
+  InsertSelect<T> from(const S& select) && {
+    return addSelect(std::move(this->data), select);
+  }
+
+ private:
+  template <typename S>
+  static InsertSelect<T> addSelect(InsertData&& data, const S& select) {
+    static_assert(std::is_same_v<types::Map<DbType, typename S::Values>,
+                                 typename T::Row>,
+                  "Selected values do not match to columns of the table");
+    static_assert(JoinsComplete<typename S::Tables, typename S::Joined>,
+                  "Referenced table is not connected by a join");
+    data.setSelect(select.data);
+    return InsertSelect<T>(std::move(data));
+  }
 };
 
 template <typename T>
-class InsertRow final : public StatementD<InsertData> {
+class InsertSelect final : public ReturningStatement<InsertData, T> {
  private:
-  using StatementD::StatementD;
+  using ReturningStatement<InsertData, T>::ReturningStatement;
+
+  friend class Insert<T>;
+
+ public:
+  ~InsertSelect() override = default;
+
+  template <typename... C>
+  InsertConflict<T> onConflict(const C&... columns) const& {
+    return InsertConflict<T>(InsertData(this->data), columns...);
+  }
+
+  template <typename... C>
+  InsertConflict<T> onConflict(const C&... columns) && {
+    return InsertConflict<T>(std::move(this->data), columns...);
+  }
+};
+
+template <typename T>
+class InsertRow final : public ReturningStatement<InsertData, T> {
+ private:
+  using ReturningStatement<InsertData, T>::ReturningStatement;
 
   template <typename... V>
-  explicit InsertRow(const InsertData& data, V&&... values) : StatementD(data) {
+  explicit InsertRow(const InsertData& data, V&&... values)
+      : ReturningStatement<InsertData, T>(data) {
     init(std::forward<V>(values)...);
   }
 
   template <typename... V>
   explicit InsertRow(InsertData&& data, V&&... values)
-      : StatementD(std::move(data)) {
+      : ReturningStatement<InsertData, T>(std::move(data)) {
     init(std::forward<V>(values)...);
   }
 
@@ -83,6 +164,16 @@ class InsertRow final : public StatementD<InsertData> {
  public:
   ~InsertRow() override = default;
 
+  template <typename... C>
+  InsertConflict<T> onConflict(const C&... columns) const& {
+    return InsertConflict<T>(InsertData(this->data), columns...);
+  }
+
+  template <typename... C>
+  InsertConflict<T> onConflict(const C&... columns) && {
+    return InsertConflict<T>(std::move(this->data), columns...);
+  }
+
  private:
   template <typename V, typename... VV>
   void addValues(V&& value, VV&&... values) {
@@ -90,20 +181,20 @@ class InsertRow final : public StatementD<InsertData> {
     static_assert(
         std::is_same_v<DbType<V>, typename types::Get<N, typename T::Row>>,
         "Value type does not match to column's one");
-    data.addValue(createBind(std::forward<V>(value)));
+    this->data.addValue(createBind(std::forward<V>(value)));
     if constexpr (types::PackSize<VV...>)
       addValues(std::forward<VV>(values)...);
   }
 };
 
 template <typename T>
-class InsertValues final : public StatementD<InsertData> {
+class InsertValues final : public ReturningStatement<InsertData, T> {
  private:
-  using StatementD::StatementD;
+  using ReturningStatement<InsertData, T>::ReturningStatement;
 
   template <typename... V>
   explicit InsertValues(const std::string& tableName, V&&... values)
-      : StatementD(tableName) {
+      : ReturningStatement<InsertData, T>(tableName) {
     addValues<types::IntList<>>(std::forward<V>(values)...);
   }
 
@@ -116,19 +207,142 @@ class InsertValues final : public StatementD<InsertData> {
 
   ~InsertValues() override = default;
 
+  template <typename... C>
+  InsertConflict<T> onConflict(const C&... columns) const& {
+    return InsertConflict<T>(InsertData(this->data), columns...);
+  }
+
+  template <typename... C>
+  InsertConflict<T> onConflict(const C&... columns) && {
+    return InsertConflict<T>(std::move(this->data), columns...);
+  }
+
  private:
   template <typename I, typename V, typename... VV>
   void addValues(V&& value, VV&&... values) {
     constexpr size_t INDEX = std::remove_cvref_t<V>::INDEX;
     static_assert(!I::contains(INDEX), "Cannot insert the same value twice");
-    data.addValue(value.getColumn().getName(), createBind(value.getValue()));
+    this->data.addValue(value.getColumn().getName(),
+                        createBind(value.getValue()));
     if constexpr (types::PackSize<VV...>)
       addValues<types::AddIntList<INDEX, I>>(std::forward<VV>(values)...);
   }
 };
 
+template <typename T>
+class InsertConflict {
+  friend class InsertRow<T>;
+  friend class InsertValues<T>;
+  friend class InsertSelect<T>;
+
+ private:
+  template <typename... C>
+  explicit InsertConflict(InsertData&& data, const C&... columns)
+      : data(std::move(data)) {
+    static_assert((std::is_same_v<TableType<C>, TableType<T>> && ...),
+                  "Conflict target must be a column of the inserted table");
+    this->data.setConflict();
+    (this->data.addConflictColumn(columns.getName()), ...);
+  }
+
+ public:
+  Upsert<T> doNothing() const& { return Upsert<T>(InsertData(data)); }
+  Upsert<T> doNothing() && { return Upsert<T>(std::move(data)); }
+
+  template <typename A, typename... AA>
+  UpsertUpdate<T> doUpdate(A&& a, AA&&... aa) const& {
+    return UpsertUpdate<T>(InsertData(data), std::forward<A>(a),
+                           std::forward<AA>(aa)...);
+  }
+
+  template <typename A, typename... AA>
+  UpsertUpdate<T> doUpdate(A&& a, AA&&... aa) && {
+    return UpsertUpdate<T>(std::move(data), std::forward<A>(a),
+                           std::forward<AA>(aa)...);
+  }
+
+ private:
+  InsertData data;
+};
+
+template <typename T>
+class Upsert final : public ReturningStatement<InsertData, T> {
+  friend class InsertConflict<T>;
+  friend class UpsertUpdate<T>;
+
+ private:
+  using ReturningStatement<InsertData, T>::ReturningStatement;
+
+ public:
+  ~Upsert() override = default;
+};
+
+template <typename T>
+class UpsertUpdate final : public ReturningStatement<InsertData, T> {
+  friend class InsertConflict<T>;
+
+  template <typename C>
+  using Tables = expr::ExprTables<expr::BoolExpr, C>;
+
+ private:
+  using ReturningStatement<InsertData, T>::ReturningStatement;
+
+  template <typename... A>
+  explicit UpsertUpdate(InsertData&& data, A&&... assignments)
+      : ReturningStatement<InsertData, T>(std::move(data)) {
+    addAssignments<types::IntList<>>(std::forward<A>(assignments)...);
+  }
+
+ public:
+  ~UpsertUpdate() override = default;
+
+  template <typename C>
+  Upsert<T> where(C&& condition) const& {
+    return addWhere<Tables<C>>(InsertData(this->data),
+                              std::forward<C>(condition));
+  }
+
+  template <typename C>
+  Upsert<T> where(C&& condition) && {
+    return addWhere<Tables<C>>(std::move(this->data),
+                              std::forward<C>(condition));
+  }
+
+ private:
+  template <typename I, typename A, typename... AA>
+  void addAssignments(A&& a, AA&&... aa) {
+    using Type = std::remove_cvref_t<A>;
+    static_assert(std::is_same_v<typename Type::Table, TableType<T>> &&
+                      types::Contains<typename Type::Tables,
+                                      types::MakeList<TableType<T>>>,
+                  "Only the inserted table can be used in the update");
+    static_assert(!I::contains(Type::INDEX),
+                  "Cannot update the same value twice");
+    this->data.addConflictAssignment(
+        a.getColumn().getName(), expr::Data(std::forward<A>(a).getExpr().data));
+    if constexpr (types::PackSize<AA...>)
+      addAssignments<types::AddIntList<Type::INDEX, I>>(
+          std::forward<AA>(aa)...);
+  }
+
+  template <typename C>
+  static Upsert<T> addWhere(InsertData&& data, expr::Condition<C>&& condition) {
+    static_assert(types::Contains<C, types::MakeList<TableType<T>>>,
+                  "Condition may refer only to the inserted table");
+    data.addConflictCondition(std::move(condition.data));
+    return Upsert<T>(std::move(data));
+  }
+};
+
 }  // namespace stmt
 
+// Refers to the value that failed to insert in DO UPDATE of an upsert
+template <typename T, typename V, size_t I>
+expr::Expression<types::MakeSet<T>, DbType<V>> excluded(
+    const Column<T, V, I>& column) {
+  return expr::Excluded<types::MakeSet<T>, DbType<V>>(column.getName());
+}
+
 template <typename T, typename... V>
 inline stmt::Insert<Table<T, V...>> insertInto(const Table<T, V...>& table) {
   return stmt::Insert<Table<T, V...>>::make(table);
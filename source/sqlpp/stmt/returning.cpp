@@ -0,0 +1,43 @@
+#include "returning.h"
+
+#include <sstream>
+
+namespace sqlpp::stmt {
+
+ReturningData::ReturningData() = default;
+ReturningData::ReturningData(const ReturningData&) = default;
+ReturningData::ReturningData(ReturningData&&) = default;
+ReturningData& ReturningData::operator=(const ReturningData&) = default;
+ReturningData& ReturningData::operator=(ReturningData&&) = default;
+
+// SQLite does not accept the 'table.*' form in RETURNING
+void ReturningData::addAll() { columns.push_back("*"); }
+
+void ReturningData::addColumn(const std::string& tableName,
+                              const std::string& columnName) {
+  columns.push_back(tableName + "." + columnName);
+}
+
+void ReturningData::addColumn(const expr::Data& expression) {
+  std::ostringstream ss;
+  expression.dump(ss);
+  columns.push_back(ss.str());
+  binds.insert(binds.end(), expression.binds.begin(), expression.binds.end());
+}
+
+void ReturningData::dump(std::ostream& stream) const {
+  if (columns.empty()) return;
+  stream << " RETURNING ";
+  bool first = true;
+  for (const auto& c : columns) {
+    if (!first) stream << ", ";
+    first = false;
+    stream << c;
+  }
+}
+
+void ReturningData::appendBinds(std::vector<Bind>& target) const {
+  target.insert(target.end(), binds.begin(), binds.end());
+}
+
+}  // namespace sqlpp::stmt
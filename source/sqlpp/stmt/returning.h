@@ -0,0 +1,99 @@
+#ifndef SRC_SQLPP_STMT_RETURNING_H_
+#define SRC_SQLPP_STMT_RETURNING_H_
+
+#include "common.h"
+
+namespace sqlpp {
+namespace stmt {
+
+class ReturningData {
+ public:
+  ReturningData();
+
+  ReturningData(const ReturningData&);
+  ReturningData(ReturningData&&);
+
+  ReturningData& operator=(const ReturningData&);
+  ReturningData& operator=(ReturningData&&);
+
+  void addAll();
+  void addColumn(const std::string& tableName, const std::string& columnName);
+  void addColumn(const expr::Data& expression);
+
+  void dump(std::ostream& stream) const;
+  bool hasBinds() const { return !binds.empty(); }
+  void appendBinds(std::vector<Bind>& target) const;
+
+ private:
+  std::vector<std::string> columns;
+  std::vector<Bind> binds;
+};
+
+template <typename D, typename V>
+class Returning final : public StatementD<D> {
+ public:
+  using Values = V;
+
+  using StatementD<D>::StatementD;
+  ~Returning() override = default;
+
+  TypedResult<Values> executeT(const Database& db) const {
+    return TypedResult<Values>(this->execute(db));
+  }
+};
+
+// Base of the INSERT and UPDATE stages that may end with a RETURNING clause;
+// the data class D keeps the clause in its 'returning' member
+template <typename D, typename T>
+class ReturningStatement : public StatementD<D> {
+ public:
+  using StatementD<D>::StatementD;
+  ~ReturningStatement() override = default;
+
+  template <typename R, typename... RR>
+  Returning<D, types::Concat<ResultValues<R>, ResultValues<RR>...>> returning(
+      R&& result, RR&&... results) const& {
+    return make(D(this->data), std::forward<R>(result),
+                std::forward<RR>(results)...);
+  }
+
+  template <typename R, typename... RR>
+  Returning<D, types::Concat<ResultValues<R>, ResultValues<RR>...>> returning(
+      R&& result, RR&&... results) && {
+    return make(std::move(this->data), std::forward<R>(result),
+                std::forward<RR>(results)...);
+  }
+
+ private:
+  template <typename... R>
+  static Returning<D, types::Concat<ResultValues<R>...>> make(D&& data,
+                                                              R&&... results) {
+    using Tables = types::Merge<ResultTables<R>...>;
+    static_assert(types::Contains<Tables, types::MakeList<TableType<T>>>,
+                  "Only the modified table can be returned");
+    (addResult(data.returning, std::forward<R>(results)), ...);
+    return Returning<D, types::Concat<ResultValues<R>...>>(std::move(data));
+  }
+
+  template <typename B, typename... U>
+  static void addResult(ReturningData& returning, const Table<B, U...>&) {
+    returning.addAll();
+  }
+
+  template <typename B, typename U, size_t I>
+  static void addResult(ReturningData& returning,
+                        const Column<B, U, I>& column) {
+    returning.addColumn(column.getTable().getName(), column.getName());
+  }
+
+  template <typename B, typename U>
+  static void addResult(ReturningData& returning,
+                        const expr::Expression<B, U>& expression) {
+    returning.addColumn(expression.data);
+  }
+};
+
+}  // namespace stmt
+}  // namespace sqlpp
+
+#endif /* SRC_SQLPP_STMT_RETURNING_H_ */
@@ -10,7 +10,16 @@ namespace sqlpp::stmt {
 SelectData::SelectData() {}
 
 SelectData::SelectData(const SelectData& other)
-    : columns(other.columns), tables(other.tables), binds(other.binds) {
+    : commonTables(other.commonTables),
+      recursive(other.recursive),
+      columns(other.columns),
+      tables(other.tables),
+      from(other.from),
+      compounds(other.compounds),
+      limit(other.limit),
+      binds(other.binds) {
+  for (const auto& j : other.joins)
+    joins.push_back({j.tableName, j.left, j.on ? j.on->clone() : nullptr});
   if (other.where) where = other.where->clone();
   for (const auto& g : other.groupBy) groupBy.emplace_back(g->clone());
   for (const auto& o : other.orderBy) orderBy.emplace_back(o->clone());
@@ -20,16 +29,24 @@ SelectData::SelectData(SelectData&&) = default;
 
 SelectData& SelectData::operator=(const SelectData& other) {
   if (this != &other) {
+    commonTables = other.commonTables;
+    recursive = other.recursive;
     columns = other.columns;
     tables = other.tables;
+    from = other.from;
+    joins.clear();
+    for (const auto& j : other.joins)
+      joins.push_back({j.tableName, j.left, j.on ? j.on->clone() : nullptr});
     if (other.where)
       where = other.where->clone();
     else
       where.reset();
     groupBy.clear();
     for (const auto& g : other.groupBy) groupBy.emplace_back(g->clone());
+    compounds = other.compounds;
     orderBy.clear();
     for (const auto& o : other.orderBy) orderBy.emplace_back(o->clone());
+    limit = other.limit;
     binds = other.binds;
   }
   return *this;
@@ -41,6 +58,34 @@ void SelectData::addColumn(const std::string& tableName,
                            const std::string& columnName) {
   columns.push_back(tableName + "." + columnName);
   tables.insert(tableName);
+  if (from.empty()) from = tableName;
+}
+
+void SelectData::addColumn(const expr::Data& expression) {
+  std::ostringstream ss;
+  expression.dump(ss);
+  columns.push_back(ss.str());
+  tables.insert(expression.tables.begin(), expression.tables.end());
+  if (from.empty() && expression.tables.size() == 1)
+    from = *expression.tables.begin();
+  binds.insert(binds.end(), expression.binds.begin(), expression.binds.end());
+}
+
+void SelectData::addJoin(const std::string& tableName, bool left) {
+  joins.push_back({tableName, left, nullptr});
+  tables.insert(tableName);
+}
+
+void SelectData::addJoinCondition(const expr::Data& cond) {
+  addJoinCondition(expr::Data(cond));
+}
+
+void SelectData::addJoinCondition(expr::Data&& cond) {
+  tables.insert(make_move_iterator(cond.tables.begin()),
+                make_move_iterator(cond.tables.end()));
+  joins.back().on = move(cond.root);
+  binds.insert(binds.end(), make_move_iterator(cond.binds.begin()),
+               make_move_iterator(cond.binds.end()));
 }
 
 void SelectData::addCondition(const expr::Data& cond) {
@@ -50,11 +95,26 @@ void SelectData::addCondition(const expr::Data& cond) {
 void SelectData::addCondition(expr::Data&& cond) {
   tables.insert(make_move_iterator(cond.tables.begin()),
                 make_move_iterator(cond.tables.end()));
-  where = move(cond.root);
+  if (where)
+    where = expr::Node::make<expr::BinaryOperator>(
+        expr::BinaryOperator::Op::AND, move(where), move(cond.root));
+  else
+    where = move(cond.root);
   binds.insert(binds.end(), make_move_iterator(cond.binds.begin()),
                make_move_iterator(cond.binds.end()));
 }
 
+void SelectData::addSeek(const std::vector<expr::Data>& keys, Order order,
+                         std::vector<Bind>&& values) {
+  std::vector<expr::Data> params;
+  for (auto&& v : values) params.emplace_back(move(v));
+  addCondition(expr::Data(
+      order == Order::ASC ? expr::BinaryOperator::Op::GT
+                          : expr::BinaryOperator::Op::LS,
+      expr::Data("", false, std::vector<expr::Data>(keys)),
+      expr::Data("", false, move(params))));
+}
+
 void SelectData::addGroupBy(const expr::Data& group) {
   addGroupBy(expr::Data(group));
 }
@@ -77,7 +137,50 @@ void SelectData::addOrderBy(expr::Data&& order) {
 
 void SelectData::addLimit(size_t l) { limit = l; }
 
-void SelectData::dump(std::ostream& stream) const {
+void SelectData::addCompound(const SelectData& other, bool all) {
+  if (!other.commonTables.empty())
+    throw std::runtime_error("Compound select cannot have a WITH clause");
+  std::ostringstream ss;
+  ss << (all ? "UNION ALL " : "UNION ");
+  other.dump(ss);
+  compounds.push_back(ss.str());
+  binds.insert(binds.end(), other.binds.begin(), other.binds.end());
+}
+
+void SelectData::addCommonTable(const std::string& name,
+                                const std::vector<std::string>& columnNames,
+                                const SelectData& definition, bool recursive) {
+  std::ostringstream ss;
+  ss << name << "(";
+  bool first = true;
+  for (const auto& c : columnNames) {
+    if (!first) ss << ", ";
+    first = false;
+    ss << c;
+  }
+  ss << ") AS (";
+  definition.dump(ss);
+  ss << ")";
+  commonTables.push_back(ss.str());
+  this->recursive = this->recursive || recursive;
+  binds.insert(binds.end(), definition.binds.begin(), definition.binds.end());
+}
+
+void SelectData::dump(std::ostream& stream) const { dump(stream, {}); }
+
+void SelectData::dump(std::ostream& stream,
+                      const std::unordered_set<std::string>& outer) const {
+  if (!commonTables.empty()) {
+    stream << (recursive ? "WITH RECURSIVE " : "WITH ");
+    bool first = true;
+    for (const auto& c : commonTables) {
+      if (!first) stream << ", ";
+      first = false;
+      stream << c;
+    }
+    stream << " ";
+  }
+
   stream << "SELECT ";
   bool first = true;
   for (const auto& c : columns) {
@@ -86,11 +189,23 @@ void SelectData::dump(std::ostream& stream) const {
     stream << c;
   }
   stream << " FROM ";
-  first = true;
-  for (auto&& t : tables) {
-    if (!first) stream << ", ";
-    first = false;
-    stream << t;
+  if (joins.empty()) {
+    first = true;
+    for (auto&& t : tables) {
+      if (outer.count(t)) continue;
+      if (!first) stream << ", ";
+      first = false;
+      stream << t;
+    }
+  } else {
+    stream << from;
+    for (const auto& j : joins) {
+      stream << (j.left ? " LEFT JOIN " : " JOIN ") << j.tableName;
+      if (j.on) {
+        stream << " ON ";
+        j.on->dump(stream);
+      }
+    }
   }
 
   if (where) {
@@ -108,6 +223,8 @@ void SelectData::dump(std::ostream& stream) const {
     }
   }
 
+  for (const auto& c : compounds) stream << " " << c;
+
   if (!orderBy.empty()) {
     stream << " ORDER BY ";
     first = true;
@@ -121,10 +238,25 @@ void SelectData::dump(std::ostream& stream) const {
   if (limit) stream << " LIMIT " << *limit;
 }
 
-Result SelectData::execute(const Database& db) const {
+Result SelectData::execute(const Database& db,
+                           const std::string& prefix) const {
   std::ostringstream ss;
-  dump(ss);
+  {
+    SQLPP_TIME(RENDER);
+    ss << prefix;
+    dump(ss);
+  }
   return db.execute(ss.str(), binds);
 }
 
+expr::Data SelectData::subquery(
+    const std::unordered_set<std::string>& outer) const {
+  std::ostringstream ss;
+  dump(ss, outer);
+  expr::Data res(expr::Node::make<expr::Subquery>(ss.str()),
+                 std::vector<Bind>(binds));
+  res.tables = outer;
+  return res;
+}
+
 }  // namespace sqlpp::stmt
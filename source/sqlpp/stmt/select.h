@@ -1,6 +1,8 @@
 #ifndef SRC_SQLPP_STMT_SELECT_H_
 #define SRC_SQLPP_STMT_SELECT_H_
 
+#include <stdexcept>
+#include <tuple>
 #include <unordered_set>
 
 #include "../expr/condition.h"
@@ -9,6 +11,11 @@
 namespace sqlpp {
 namespace stmt {
 
+template <typename T>
+class Insert;
+
+class InsertData;
+
 class SelectData {
  public:
   SelectData();
@@ -20,10 +27,18 @@ class SelectData {
   SelectData& operator=(SelectData&&);
 
   void addColumn(const std::string& tableName, const std::string& columnName);
+  void addColumn(const expr::Data& expression);
+
+  void addJoin(const std::string& tableName, bool left);
+  void addJoinCondition(const expr::Data& cond);
+  void addJoinCondition(expr::Data&& cond);
 
   void addCondition(const expr::Data& cond);
   void addCondition(expr::Data&& cond);
 
+  void addSeek(const std::vector<expr::Data>& keys, Order order,
+               std::vector<Bind>&& values);
+
   void addGroupBy(const expr::Data& group);
   void addGroupBy(expr::Data&& group);
 
@@ -32,69 +47,152 @@ class SelectData {
 
   void addLimit(size_t limit);
 
+  void addCompound(const SelectData& other, bool all);
+
+  void addCommonTable(const std::string& name,
+                      const std::vector<std::string>& columnNames,
+                      const SelectData& definition, bool recursive);
+
   void dump(std::ostream& stream) const;
-  Result execute(const Database& db) const;
+  Result execute(const Database& db, const std::string& prefix = "") const;
+
+  expr::Data subquery(const std::unordered_set<std::string>& outer = {}) const;
 
  private:
+  void dump(std::ostream& stream,
+            const std::unordered_set<std::string>& outer) const;
+
+  struct Join {
+    std::string tableName;
+    bool left;
+    expr::Node::Ptr on;
+  };
+
+  std::vector<std::string> commonTables;
+  bool recursive = false;
   std::vector<std::string> columns;
   std::unordered_set<std::string> tables;
+  std::string from;
+  std::vector<Join> joins;
   expr::Node::Ptr where;
   std::vector<expr::Node::Ptr> groupBy;
+  std::vector<std::string> compounds;
   std::vector<expr::Node::Ptr> orderBy;
   std::optional<size_t> limit;
   std::vector<Bind> binds;
+
+  friend class InsertData;
 };
 
-template <typename T, typename V>
+// J is the list of tables connected with FROM and JOIN. It holds only the
+// table of the first result until join() is used, in that case all the tables
+// are listed in FROM. Otherwise every referenced table must be joined.
+template <typename T, typename J>
+inline constexpr bool JoinsComplete =
+    types::Size<J> <= 1 || types::Contains<T, J>;
+
+template <typename T, typename V, typename J>
 class SelectLimit : public StatementD<SelectData> {
+  template <typename A, typename B, typename C>
+  friend class SelectGroupBy;
+
+  friend class With;
+
+  template <typename A>
+  friend class Insert;
+
  public:
   using Tables = T;
   using Values = V;
+  using Joined = J;
 
   using StatementD<SelectData>::StatementD;
 
   ~SelectLimit() override = default;
 
   TypedResult<Values> executeT(const Database& db) const {
+    static_assert(JoinsComplete<T, J>,
+                  "Referenced table is not connected by a join");
     return TypedResult<Values>(execute(db));
   }
+
+  // Tables of the outer query are not listed in FROM of a correlated
+  // subquery, so its condition refers to the current outer row. A subquery
+  // has no implicit cross joins: a table it does not join must be passed as
+  // outer, otherwise a forgotten outer table would make it uncorrelated.
+  template <typename... O>
+  expr::Data subquery(const O&... outer) const {
+    using Outer = types::MakeSet<TableType<O>...>;
+    using Inner = types::Subtract<T, Outer>;
+    static_assert(types::Contains<Outer, T>,
+                  "Outer table is not referenced by the subquery");
+    static_assert(types::Size<Inner> > 0,
+                  "Subquery refers only to outer tables");
+    static_assert(types::Size<Inner> == 1 || types::Contains<Inner, J>,
+                  "Subquery table is neither joined nor an outer table");
+    static_assert(JoinsComplete<Inner, J>,
+                  "Referenced table is not connected by a join");
+    return this->data.subquery({outer.getName()...});
+  }
 };
 
-template <typename T, typename V>
-class SelectOrderBy : public SelectLimit<T, V> {
+template <typename T, typename V, typename J>
+class SelectOrderBy : public SelectLimit<T, V, J> {
  public:
-  using SelectLimit<T, V>::SelectLimit;
+  using SelectLimit<T, V, J>::SelectLimit;
 
   ~SelectOrderBy() override = default;
 
-  SelectLimit<T, V> limit(size_t l) const& {
+  SelectLimit<T, V, J> limit(size_t l) const& {
     return addLimit(SelectData(this->data), l);
   }
 
-  SelectLimit<T, V> limit(size_t l) && {
+  SelectLimit<T, V, J> limit(size_t l) && {
     return addLimit(std::move(this->data), l);
   }
 
  private:
-  static SelectLimit<T, V> addLimit(SelectData&& data, size_t l) {
+  static SelectLimit<T, V, J> addLimit(SelectData&& data, size_t l) {
+    static_assert(JoinsComplete<T, J>,
+                  "Referenced table is not connected by a join");
     data.addLimit(l);
-    return SelectLimit<T, V>(std::move(data));
+    return SelectLimit<T, V, J>(std::move(data));
   }
 };
 
-template <typename T, typename V>
-class SelectGroupBy : public SelectOrderBy<T, V> {
+template <typename T, typename V, typename J>
+class SelectGroupBy : public SelectOrderBy<T, V, J> {
   template <typename... E>
   using SelectOrderByType =
-      SelectOrderBy<types::Merge<T, expr::ExprTables<expr::AllExpr, E...>>, V>;
+      SelectOrderBy<types::Merge<T, expr::OrderTables<E...>>, V, J>;
 
  public:
-  using SelectOrderBy<T, V>::SelectOrderBy;
+  using SelectOrderBy<T, V, J>::SelectOrderBy;
+
+  template <typename S>
+  SelectOrderBy<T, V, J> unionAll(const S& select) const& {
+    return addCompound(SelectData(this->data), select, true);
+  }
+
+  template <typename S>
+  SelectOrderBy<T, V, J> unionAll(const S& select) && {
+    return addCompound(std::move(this->data), select, true);
+  }
+
+  template <typename S>
+  SelectOrderBy<T, V, J> unionDistinct(const S& select) const& {
+    return addCompound(SelectData(this->data), select, false);
+  }
+
+  template <typename S>
+  SelectOrderBy<T, V, J> unionDistinct(const S& select) && {
+    return addCompound(std::move(this->data), select, false);
+  }
 
   template <typename E, typename... EE>
   SelectOrderByType<E, EE...> orderBy(E&& expression,
                                       EE&&... expressions) const& {
-    return addGroupBy(SelectData(this->data), std::forward<E>(expression),
+    return addOrderBy(SelectData(this->data), std::forward<E>(expression),
                       std::forward<EE>(expressions)...);
   }
 
@@ -109,6 +207,9 @@ class SelectGroupBy : public SelectOrderBy<T, V> {
   static SelectOrderByType<E, EE...> addOrderBy(SelectData&& data,
                                                 E&& expression,
                                                 EE&&... expressions) {
+    using Tables = typename SelectOrderByType<E, EE...>::Tables;
+    static_assert(JoinsComplete<Tables, J>,
+                  "Referenced table is not connected by a join");
     addOrder(data, std::forward<E>(expression));
     if constexpr (types::PackSize<EE...> == 0)
       return SelectOrderByType<E, EE...>(std::move(data));
@@ -120,16 +221,45 @@ class SelectGroupBy : public SelectOrderBy<T, V> {
   static void addOrder(SelectData& data, E&& expression) {
     data.addOrderBy(std::forward<E>(expression).data);
   }
+
+  // ORDER BY and LIMIT of the right-hand select would apply to the whole
+  // compound, so they can only follow it
+  template <typename S>
+  static SelectOrderBy<T, V, J> addCompound(SelectData&& data, const S& select,
+                                            bool all) {
+    static_assert(
+        std::is_base_of_v<SelectGroupBy<typename S::Tables, typename S::Values,
+                                        typename S::Joined>,
+                          S>,
+        "Compound select cannot have ORDER BY or LIMIT");
+    static_assert(std::is_same_v<types::Map<DbType, V>,
+                                 types::Map<DbType, typename S::Values>>,
+                  "Compound select value types do not match");
+    static_assert(JoinsComplete<T, J> &&
+                      JoinsComplete<typename S::Tables, typename S::Joined>,
+                  "Referenced table is not connected by a join");
+    data.addCompound(select.data, all);
+    return SelectOrderBy<T, V, J>(std::move(data));
+  }
 };
 
-template <typename T, typename V>
-class SelectWhere : public SelectGroupBy<T, V> {
+template <typename T, typename V, typename J, typename... K>
+class SelectPager;
+
+template <typename T, typename V, typename J>
+class SelectWhere : public SelectGroupBy<T, V, J> {
   template <typename... E>
   using SelectGroupByType =
-      SelectGroupBy<types::Merge<T, expr::ExprTables<expr::AllExpr, E...>>, V>;
+      SelectGroupBy<types::Merge<T, expr::ExprTables<expr::AllExpr, E...>>, V,
+                    J>;
+
+  template <typename... K>
+  using SelectPagerType =
+      SelectPager<types::Merge<T, types::MakeSet<TableType<K>...>>, V, J,
+                  DbType<types::Head<ValueType<K>>>...>;
 
  public:
-  using SelectGroupBy<T, V>::SelectGroupBy;
+  using SelectGroupBy<T, V, J>::SelectGroupBy;
 
   ~SelectWhere() override = default;
 
@@ -146,11 +276,27 @@ class SelectWhere : public SelectGroupBy<T, V> {
                       std::forward<EE>(expressions)...);
   }
 
+  template <typename K, typename... KK>
+  SelectPagerType<K, KK...> pageBy(size_t size, Order order, const K& key,
+                                   const KK&... keys) const {
+    return SelectPagerType<K, KK...>(SelectData(this->data), size, order, key,
+                                     keys...);
+  }
+
+  template <typename K, typename... KK>
+  SelectPagerType<K, KK...> pageBy(size_t size, const K& key,
+                                   const KK&... keys) const {
+    return pageBy(size, Order::ASC, key, keys...);
+  }
+
  private:
   template <typename E, typename... EE>
   static SelectGroupByType<E, EE...> addGroupBy(SelectData&& data,
                                                 E&& expression,
                                                 EE&&... expressions) {
+    using Tables = typename SelectGroupByType<E, EE...>::Tables;
+    static_assert(JoinsComplete<Tables, J>,
+                  "Referenced table is not connected by a join");
     addGroup(data, std::forward<E>(expression));
     if constexpr (types::PackSize<EE...> == 0)
       return SelectGroupByType<E, EE...>(std::move(data));
@@ -164,20 +310,38 @@ class SelectWhere : public SelectGroupBy<T, V> {
   }
 };
 
-template <typename T, typename V>
-class Select : public SelectWhere<T, V> {
+template <typename T, typename V, typename J, typename B>
+class SelectJoin;
+
+template <typename T, typename V, typename J>
+class SelectOpenJoin;
+
+template <typename T, typename V, typename J>
+class Select : public SelectWhere<T, V, J> {
   template <typename C>
   using SelectWhereType =
-      SelectWhere<types::Merge<T, expr::ExprTables<expr::BoolExpr, C>>, V>;
+      SelectWhere<types::Merge<T, expr::ExprTables<expr::BoolExpr, C>>, V, J>;
+
+  template <typename B>
+  using SelectJoinType = SelectJoin<T, V, J, TableType<B>>;
 
  public:
-  using SelectWhere<T, V>::SelectWhere;
+  using SelectWhere<T, V, J>::SelectWhere;
 
   ~Select() override = default;
 
   template <typename R, typename... RR>
-  static Select<T, V> make(R&& result, RR&&... results) {
-    Select<T, V> ret;
+  static Select<T, V, J> make(R&& result, RR&&... results) {
+    return make(SelectData(), std::forward<R>(result),
+                std::forward<RR>(results)...);
+  }
+
+  template <typename R, typename... RR>
+  static Select<T, V, J> make(SelectData&& data, R&& result,
+                              RR&&... results) {
+    static_assert(types::Size<T> > 0,
+                  "Select must refer to a table, e.g. use count(table)");
+    Select<T, V, J> ret(std::move(data));
     ret.addResults(std::forward<R>(result), std::forward<RR>(results)...);
     return ret;
   }
@@ -192,6 +356,26 @@ class Select : public SelectWhere<T, V> {
     return addWhere(std::move(this->data), std::forward<C>(condition));
   }
 
+  template <typename B>
+  SelectJoinType<B> join(const B& table) const& {
+    return SelectJoinType<B>(SelectData(this->data), table.getName(), false);
+  }
+
+  template <typename B>
+  SelectJoinType<B> join(const B& table) && {
+    return SelectJoinType<B>(std::move(this->data), table.getName(), false);
+  }
+
+  template <typename B>
+  SelectJoinType<B> leftJoin(const B& table) const& {
+    return SelectJoinType<B>(SelectData(this->data), table.getName(), true);
+  }
+
+  template <typename B>
+  SelectJoinType<B> leftJoin(const B& table) && {
+    return SelectJoinType<B>(std::move(this->data), table.getName(), true);
+  }
+
  private:
   template <typename R, typename... RR>
   void addResults(R&& result, RR&&... results) {
@@ -210,23 +394,263 @@ class Select : public SelectWhere<T, V> {
     this->data.addColumn(column.getTable().getName(), column.getName());
   }
 
+  template <typename B, typename U>
+  void addResult(const expr::Expression<B, U>& expression) {
+    this->data.addColumn(expression.data);
+  }
+
   template <typename C>
   static SelectWhereType<C> addWhere(SelectData&& data, C&& condition) {
+    static_assert(JoinsComplete<typename SelectWhereType<C>::Tables, J>,
+                  "Referenced table is not connected by a join");
     data.addCondition(std::forward<C>(condition).data);
     return SelectWhereType<C>(std::move(data));
   }
 };
 
+// Join chain that still misses a table referenced by the results or the join
+// conditions. It is not a statement, only more joins can follow, so a select
+// with an unjoined table cannot be executed or rendered.
+template <typename T, typename V, typename J>
+class SelectOpenJoin {
+  template <typename B>
+  using SelectJoinType = SelectJoin<T, V, J, TableType<B>>;
+
+  template <typename A, typename B, typename C, typename D>
+  friend class SelectJoin;
+
+  explicit SelectOpenJoin(SelectData&& data) : data(std::move(data)) {}
+
+ public:
+  template <typename B>
+  SelectJoinType<B> join(const B& table) const& {
+    return SelectJoinType<B>(SelectData(data), table.getName(), false);
+  }
+
+  template <typename B>
+  SelectJoinType<B> join(const B& table) && {
+    return SelectJoinType<B>(std::move(data), table.getName(), false);
+  }
+
+  template <typename B>
+  SelectJoinType<B> leftJoin(const B& table) const& {
+    return SelectJoinType<B>(SelectData(data), table.getName(), true);
+  }
+
+  template <typename B>
+  SelectJoinType<B> leftJoin(const B& table) && {
+    return SelectJoinType<B>(std::move(data), table.getName(), true);
+  }
+
+ private:
+  SelectData data;
+};
+
+template <typename T, typename V, typename J, typename B>
+class SelectJoin {
+  static_assert(types::Size<J> > 0,
+                "The first result must refer to a single table to be joined");
+  static_assert(!types::Contains<B, J>, "The table is already joined");
+
+  using JoinedType = types::InsertBack<B, J>;
+
+  template <typename C>
+  using SelectTables = types::Merge<T, types::MakeList<B>,
+                                    expr::ExprTables<expr::BoolExpr, C>>;
+
+  template <typename C>
+  using SelectType =
+      std::conditional_t<JoinsComplete<SelectTables<C>, JoinedType>,
+                         Select<SelectTables<C>, V, JoinedType>,
+                         SelectOpenJoin<SelectTables<C>, V, JoinedType>>;
+
+  friend class Select<T, V, J>;
+  friend class SelectOpenJoin<T, V, J>;
+
+  SelectJoin(SelectData&& data, const std::string& tableName, bool left)
+      : data(std::move(data)) {
+    this->data.addJoin(tableName, left);
+  }
+
+ public:
+  template <typename C>
+  SelectType<C> on(C&& condition) const& {
+    return addOn(SelectData(data), std::forward<C>(condition));
+  }
+
+  template <typename C>
+  SelectType<C> on(C&& condition) && {
+    return addOn(std::move(data), std::forward<C>(condition));
+  }
+
+ private:
+  template <typename C>
+  static SelectType<C> addOn(SelectData&& data, C&& condition) {
+    static_assert(
+        types::Contains<expr::ExprTables<expr::BoolExpr, C>, JoinedType>,
+        "Join condition refers to a table that is not joined yet");
+    data.addJoinCondition(std::forward<C>(condition).data);
+    return SelectType<C>(std::move(data));
+  }
+
+  SelectData data;
+};
+
+// Common table expressions are declared as ordinary tables, the definition
+// has to return the values of the table row
+class With {
+ public:
+  template <typename B, typename S>
+  With(const B& table, const S& definition, bool recursive) {
+    add(table, definition, recursive);
+  }
+
+  template <typename B, typename S>
+  With&& with(const B& table, const S& definition) && {
+    add(table, definition, false);
+    return std::move(*this);
+  }
+
+  template <typename B, typename S>
+  With&& withRecursive(const B& table, const S& definition) && {
+    add(table, definition, true);
+    return std::move(*this);
+  }
+
+  template <typename R, typename... RR>
+  auto select(R&& result, RR&&... results) &&;
+
+ private:
+  template <typename B, typename S>
+  void add(const B& table, const S& definition, bool recursive) {
+    static_assert(std::is_same_v<typename B::Row,
+                                 types::Map<DbType, typename S::Values>>,
+                  "Common table definition does not match to table's row");
+    static_assert(JoinsComplete<typename S::Tables, typename S::Joined>,
+                  "Referenced table is not connected by a join");
+    std::vector<std::string> columnNames;
+    for (size_t i = 0; i < B::COLUMN_COUNT; ++i)
+      columnNames.push_back(table.getColumnName(i));
+    data.addCommonTable(table.getName(), columnNames, definition.data,
+                        recursive);
+  }
+
+  SelectData data;
+};
+
+// Keyset pagination: every page is ordered by the key columns and continues
+// after the key of the last row seen, so no rows are skipped with OFFSET.
+// Key columns are added to the results after the selected ones, they have to
+// be NOT NULL and unique together.
+template <typename T, typename V, typename J, typename... K>
+class SelectPager {
+  template <typename A, typename B, typename C>
+  friend class SelectWhere;
+
+  template <typename... C>
+  SelectPager(SelectData&& data, size_t size, Order order, const C&... keys)
+      : data(std::move(data)), size(size), order(order) {
+    static_assert((requires { typename C::TableType; } && ...),
+                  "Page keys must be columns");
+    (addKey(keys.getTable().getName(), keys.getName()), ...);
+  }
+
+ public:
+  using Key = std::tuple<K...>;
+
+  SelectLimit<T, V, J> page() const {
+    static_assert(JoinsComplete<T, J>,
+                  "Referenced table is not connected by a join");
+    SelectData res(data);
+    if (last)
+      res.addSeek(keys, order, std::apply(makeBinds, *last));
+    for (const auto& k : keys) res.addOrderBy(expr::Data(order, k));
+    res.addLimit(size);
+    return SelectLimit<T, V, J>(std::move(res));
+  }
+
+  void remember(Result& result) {
+    if (!result.hasData()) return;
+    size_t first = result.count() - sizeof...(K);
+    last = readKey(result, first, std::index_sequence_for<K...>());
+  }
+
+  void seek(const K&... key) { last.emplace(key...); }
+
+  void reset() { last.reset(); }
+
+  const std::optional<Key>& getLast() const { return last; }
+
+ private:
+  void addKey(const std::string& tableName, const std::string& columnName) {
+    data.addColumn(tableName, columnName);
+    keys.emplace_back(tableName, columnName);
+  }
+
+  static std::vector<Bind> makeBinds(const K&... key) {
+    return {createBind(key)...};
+  }
+
+  template <size_t... I>
+  static Key readKey(Result& result, size_t first, std::index_sequence<I...>) {
+    auto values = std::make_tuple(result.as<K>(first + I)...);
+    if (!(std::get<I>(values) && ...))
+      throw std::runtime_error("Page key column is NULL");
+    return Key(*std::get<I>(values)...);
+  }
+
+  SelectData data;
+  std::vector<expr::Data> keys;
+  size_t size;
+  Order order;
+  std::optional<Key> last;
+};
+
+// Only a result from a single table can be a base for joins
+template <typename R>
+using ResultJoined = std::conditional_t<types::Size<ResultTables<R>> == 1,
+                                        ResultTables<R>, types::List<>>;
+
+template <typename R, typename... RR>
+using SelectType =
+    Select<types::Merge<ResultTables<R>, ResultTables<RR>...>,
+           types::Concat<ResultValues<R>, ResultValues<RR>...>,
+           ResultJoined<R>>;
+
 }  // namespace stmt
 
 template <typename R, typename... RR>
 inline auto select(R&& result, RR&&... results) {
-  using Tables = types::MakeSet<TableType<std::remove_cvref_t<R>>,
-                                TableType<std::remove_cvref_t<RR>>...>;
-  using Values = types::Concat<ValueType<std::remove_cvref_t<R>>,
-                               ValueType<std::remove_cvref_t<RR>>...>;
-  return stmt::Select<Tables, Values>::make(std::forward<R>(result),
-                                            std::forward<RR>(results)...);
+  return stmt::SelectType<R, RR...>::make(std::forward<R>(result),
+                                          std::forward<RR>(results)...);
+}
+
+template <typename R, typename... RR>
+auto stmt::With::select(R&& result, RR&&... results) && {
+  return SelectType<R, RR...>::make(std::move(data), std::forward<R>(result),
+                                    std::forward<RR>(results)...);
+}
+
+template <typename B, typename S>
+inline stmt::With with(const B& table, const S& definition) {
+  return stmt::With(table, definition, false);
+}
+
+template <typename B, typename S>
+inline stmt::With withRecursive(const B& table, const S& definition) {
+  return stmt::With(table, definition, true);
+}
+
+template <typename E>
+expr::OrderTerm<expr::ExprTables<expr::AnyExpr, E>> asc(E&& e) {
+  return expr::OrderTerm<expr::ExprTables<expr::AnyExpr, E>>(
+      Order::ASC, std::forward<E>(e));
+}
+
+template <typename E>
+expr::OrderTerm<expr::ExprTables<expr::AnyExpr, E>> desc(E&& e) {
+  return expr::OrderTerm<expr::ExprTables<expr::AnyExpr, E>>(
+      Order::DESC, std::forward<E>(e));
 }
 
 }  // namespace sqlpp
@@ -9,7 +9,10 @@ namespace sqlpp::stmt {
 UpdateData::UpdateData(const std::string& tableName) : tableName(tableName) {}
 
 UpdateData::UpdateData(const UpdateData& other)
-    : tableName(other.tableName), binds(other.binds) {
+    : tableName(other.tableName),
+      from(other.from),
+      binds(other.binds),
+      returning(other.returning) {
   for (const auto& a : other.assignemts)
     assignemts.emplace_back(get<0>(a), get<1>(a)->clone());
   if (other.root) root = other.root->clone();
@@ -20,7 +23,9 @@ UpdateData::UpdateData(UpdateData&&) = default;
 UpdateData& UpdateData::operator=(const UpdateData& other) {
   if (this != &other) {
     tableName = other.tableName;
+    from = other.from;
     binds = other.binds;
+    returning = other.returning;
     for (const auto& a : other.assignemts)
       assignemts.emplace_back(get<0>(a), get<1>(a)->clone());
     if (other.root) root = other.root->clone();
@@ -41,6 +46,10 @@ void UpdateData::addAssignment(const std::string& column, expr::Data&& data) {
                make_move_iterator(data.binds.end()));
 }
 
+void UpdateData::addFrom(const std::string& tableName) {
+  from.push_back(tableName);
+}
+
 void UpdateData::addCondition(const expr::Data& cond) {
   addCondition(expr::Data(cond));
 }
@@ -61,16 +70,33 @@ void UpdateData::dump(std::ostream& stream) const {
     get<1>(a)->dump(stream);
   }
 
+  if (!from.empty()) {
+    stream << " FROM ";
+    for (size_t i = 0; i < from.size(); ++i) {
+      if (i != 0) stream << ", ";
+      stream << from[i];
+    }
+  }
+
   if (root) {
     stream << " WHERE ";
     root->dump(stream);
   }
+  returning.dump(stream);
 }
 
-Result UpdateData::execute(const Database& db) const {
+Result UpdateData::execute(const Database& db,
+                           const std::string& prefix) const {
   std::ostringstream ss;
-  dump(ss);
-  return db.execute(ss.str(), binds);
+  {
+    SQLPP_TIME(RENDER);
+    ss << prefix;
+    dump(ss);
+  }
+  if (!returning.hasBinds()) return db.execute(ss.str(), binds);
+  auto allBinds = binds;
+  returning.appendBinds(allBinds);
+  return db.execute(ss.str(), allBinds);
 }
 
 }  // namespace sqlpp::stmt
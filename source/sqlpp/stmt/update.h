@@ -3,7 +3,7 @@
 
 #include "../expr/condition.h"
 #include "../expr/node.h"
-#include "common.h"
+#include "returning.h"
 
 namespace sqlpp {
 namespace stmt {
@@ -21,53 +21,98 @@ class UpdateData {
   void addAssignment(const std::string& column, const expr::Data& data);
   void addAssignment(const std::string& column, expr::Data&& data);
 
+  void addFrom(const std::string& tableName);
+
   void addCondition(const expr::Data& cond);
   void addCondition(expr::Data&& cond);
 
   void dump(std::ostream& stream) const;
-  Result execute(const Database& db) const;
+  Result execute(const Database& db, const std::string& prefix = "") const;
 
  private:
   std::string tableName;
   std::vector<std::tuple<std::string, expr::Node::Ptr>> assignemts;
+  std::vector<std::string> from;
   std::vector<Bind> binds;
   expr::Node::Ptr root;
+  ReturningData returning;
+
+  template <typename A, typename B>
+  friend class ReturningStatement;
 };
 
-template <typename T, typename C>
+// U lists the tables referenced by the statement so far, F lists the tables it
+// may refer to, i.e. the updated table and the ones added with from()
+template <typename T, typename U, typename F>
 class UpdateWhere;
 
-template <typename T>
-class Update final : public StatementD<UpdateData> {
+template <typename T, typename U, typename F = types::MakeList<T>>
+class Update;
+
+template <typename T, typename U, typename F = types::MakeList<T>>
+class UpdateOpenFrom;
+
+// An update can be executed only when every referenced table is available
+template <typename T, typename U, typename F = types::MakeList<T>>
+using UpdateStage = std::conditional_t<types::Contains<U, F>, Update<T, U, F>,
+                                       UpdateOpenFrom<T, U, F>>;
+
+template <typename T, typename U, typename F>
+class Update final : public ReturningStatement<UpdateData, T> {
+  template <typename A, typename B, typename C>
+  friend class Update;
+
+  template <typename A, typename B, typename C>
+  friend class UpdateOpenFrom;
+
+  template <typename C>
+  using UpdateWhereType =
+      UpdateWhere<T, types::Merge<U, expr::ExprTables<expr::BoolExpr, C>>, F>;
+
+  template <typename... B>
+  using UpdateFromType = UpdateStage<T, U, types::Concat<F, types::List<B...>>>;
+
  private:
-  using StatementD::StatementD;
+  using ReturningStatement<UpdateData, T>::ReturningStatement;
 
   template <typename... A>
   explicit Update(const std::string& tableName, A&&... assignments)
-      : StatementD(tableName) {
+      : ReturningStatement<UpdateData, T>(tableName) {
     addAssignments<types::IntList<>>(std::forward<A>(assignments)...);
   }
 
  public:
   template <typename A, typename... AA>
-  static Update<T> make(A&& a, AA&&... aa) {
-    return Update<T>(a.getColumn().getTable().getName(), std::forward<A>(a),
-                     std::forward<AA>(aa)...);
+  static Update<T, U, F> make(A&& a, AA&&... aa) {
+    return Update<T, U, F>(a.getColumn().getTable().getName(),
+                           std::forward<A>(a), std::forward<AA>(aa)...);
   }
 
   ~Update() override = default;
 
+  template <typename B, typename... BB>
+  UpdateFromType<TableType<B>, TableType<BB>...> from(const B& table,
+                                                      const BB&... tables)
+      const& {
+    return addFrom(UpdateData(this->data), table, tables...);
+  }
+
+  template <typename B, typename... BB>
+  UpdateFromType<TableType<B>, TableType<BB>...> from(const B& table,
+                                                      const BB&... tables) && {
+    return addFrom(std::move(this->data), table, tables...);
+  }
+
   template <typename C>
-  UpdateWhere<T, expr::ExprTables<expr::BoolExpr, C>> where(
-      C&& condition) const& {
-    return UpdateWhere<T, expr::ExprTables<expr::BoolExpr, C>>(
-        UpdateData(data), std::forward<C>(condition));
+  UpdateWhereType<C> where(C&& condition) const& {
+    return UpdateWhereType<C>(UpdateData(this->data),
+                              std::forward<C>(condition));
   }
 
   template <typename C>
-  UpdateWhere<T, expr::ExprTables<expr::BoolExpr, C>> where(C&& condition) && {
-    return UpdateWhere<T, expr::ExprTables<expr::BoolExpr, C>>(
-        std::move(data), std::forward<C>(condition));
+  UpdateWhereType<C> where(C&& condition) && {
+    return UpdateWhereType<C>(std::move(this->data),
+                              std::forward<C>(condition));
   }
 
  private:
@@ -75,22 +120,70 @@ class Update final : public StatementD<UpdateData> {
   void addAssignments(A&& a, AA&&... aa) {
     constexpr size_t INDEX = std::remove_cvref_t<A>::INDEX;
     static_assert(!I::contains(INDEX), "Cannot update the same value twice");
-    data.addAssignment(a.getColumn().getName(),
-                       std::forward<A>(a).getExpr().data);
+    this->data.addAssignment(a.getColumn().getName(),
+                             std::forward<A>(a).getExpr().data);
     if constexpr (types::PackSize<AA...>)
       addAssignments<types::AddIntList<INDEX, I>>(std::forward<AA>(aa)...);
   }
+
+  template <typename... B>
+  static UpdateFromType<TableType<B>...> addFrom(UpdateData&& data,
+                                                 const B&... tables) {
+    using Added = types::MakeSet<TableType<B>...>;
+    static_assert(types::Size<Added> == sizeof...(B) &&
+                      types::Size<types::Subtract<Added, F>> == sizeof...(B),
+                  "Table is already used in the update");
+    (data.addFrom(tables.getName()), ...);
+    return UpdateFromType<TableType<B>...>(std::move(data));
+  }
 };
 
-template <typename T, typename C>
-class UpdateWhere final : public StatementD<UpdateData> {
-  friend class Update<T>;
+// Update whose assignments refer to tables that are not listed with from()
+// yet. It is not a statement, only from() can follow.
+template <typename T, typename U, typename F>
+class UpdateOpenFrom {
+  template <typename A, typename B, typename C>
+  friend class Update;
+
+  explicit UpdateOpenFrom(UpdateData&& data) : data(std::move(data)) {}
+
+ public:
+  template <typename A, typename... AA>
+  static UpdateOpenFrom<T, U, F> make(A&& a, AA&&... aa) {
+    return UpdateOpenFrom<T, U, F>(
+        std::move(Update<T, U, F>::make(std::forward<A>(a),
+                                        std::forward<AA>(aa)...)
+                      .data));
+  }
+
+  template <typename B, typename... BB>
+  auto from(const B& table, const BB&... tables) const& {
+    return Update<T, U, F>(UpdateData(data)).from(table, tables...);
+  }
+
+  template <typename B, typename... BB>
+  auto from(const B& table, const BB&... tables) && {
+    return Update<T, U, F>(std::move(data)).from(table, tables...);
+  }
 
  private:
-  using StatementD::StatementD;
+  UpdateData data;
+};
+
+template <typename T, typename U, typename F>
+class UpdateWhere final : public ReturningStatement<UpdateData, T> {
+  template <typename A, typename B, typename C>
+  friend class Update;
+
+  static_assert(types::Contains<U, F>,
+                "Referenced table is neither updated nor listed in FROM");
+
+ private:
+  using ReturningStatement<UpdateData, T>::ReturningStatement;
 
+  template <typename C>
   UpdateWhere(UpdateData&& data, expr::Condition<C>&& condition)
-      : StatementD(std::move(data)) {
+      : ReturningStatement<UpdateData, T>(std::move(data)) {
     this->data.addCondition(std::move(condition.data));
   }
 
@@ -101,9 +194,16 @@ class UpdateWhere final : public StatementD<UpdateData> {
 }  // namespace stmt
 
 template <typename A, typename... AA>
-stmt::Update<typename A::Table> update(A&& a, AA&&... aa) {
-  return stmt::Update<typename A::Table>::make(std::forward<A>(a),
-                                               std::forward<AA>(aa)...);
+using UpdateType = stmt::UpdateStage<
+    typename std::remove_cvref_t<A>::Table,
+    types::Merge<types::MakeList<typename std::remove_cvref_t<A>::Table>,
+                 typename std::remove_cvref_t<A>::Tables,
+                 typename std::remove_cvref_t<AA>::Tables...>>;
+
+template <typename A, typename... AA>
+UpdateType<A, AA...> update(A&& a, AA&&... aa) {
+  return UpdateType<A, AA...>::make(std::forward<A>(a),
+                                    std::forward<AA>(aa)...);
 }
 
 }  // namespace sqlpp
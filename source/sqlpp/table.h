@@ -2,6 +2,7 @@
 #define SQLPP_TABLE_H_
 
 #include <array>
+#include <optional>
 #include <string>
 
 #include "column.h"
@@ -9,6 +10,14 @@
 
 namespace sqlpp {
 
+template <size_t... I>
+struct PrimaryKey : types::IntList<I...> {
+  static constexpr size_t SIZE = sizeof...(I);
+};
+
+template <typename T>
+using PrimaryKeyType = typename T::PrimaryKey;
+
 template <typename T, typename... V>
 class Table {
  public:
@@ -25,6 +34,12 @@ class Table {
 
   static constexpr size_t COLUMN_COUNT = types::PackSize<V...>;
 
+  // Derived tables redeclare these to change the table layout, e.g.
+  // "using PrimaryKey = sqlpp::PrimaryKey<0>;" makes the first column the key.
+  using PrimaryKey = sqlpp::PrimaryKey<>;
+  static constexpr bool WITHOUT_ROWID = false;
+  static constexpr bool STRICT = false;
+
   Table(std::string name, std::array<std::string, COLUMN_COUNT> columnNames)
       : name(std::move(name)), columnNames(std::move(columnNames)) {}
   virtual ~Table() = default;
@@ -38,9 +53,28 @@ class Table {
 
   const std::string& getColumnName(size_t i) const { return columnNames[i]; }
 
+  bool isNotNull(size_t i) const { return notNull[i]; }
+
+  const std::optional<std::string>& getDefault(size_t i) const {
+    return defaults[i];
+  }
+
+ protected:
+  template <size_t N>
+  void setNotNull() {
+    notNull[N] = true;
+  }
+
+  template <size_t N>
+  void setDefault(const types::Get<N, ValueType>& value) {
+    defaults[N] = createLiteral(value);
+  }
+
  private:
   const std::string name;
   const std::array<std::string, COLUMN_COUNT> columnNames;
+  std::array<bool, COLUMN_COUNT> notNull{};
+  std::array<std::optional<std::string>, COLUMN_COUNT> defaults;
 };
 
 }  // namespace sqlpp
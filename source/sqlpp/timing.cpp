@@ -0,0 +1,53 @@
+#include "timing.h"
+
+#include <atomic>
+
+namespace sqlpp::timing {
+
+static thread_local Counters local;
+// Bit per phase of the open outer scopes of the thread
+static thread_local unsigned active = 0;
+static std::atomic<Sink> sink = nullptr;
+
+const char* name(Phase phase) {
+  switch (phase) {
+    case Phase::BUILD:
+      return "build";
+    case Phase::RENDER:
+      return "render";
+    case Phase::PREPARE:
+      return "prepare";
+    case Phase::BIND:
+      return "bind";
+    case Phase::STEP:
+      return "step";
+    case Phase::DECODE:
+      return "decode";
+  }
+  return "unknown";
+}
+
+const Counters& counters() { return local; }
+
+void reset() { local = Counters(); }
+
+void setSink(Sink next) { sink.store(next, std::memory_order_release); }
+
+Scope::Scope(Phase phase)
+    : phase(phase), outer(!(active & (1u << static_cast<unsigned>(phase)))) {
+  if (!outer) return;
+  active |= 1u << static_cast<unsigned>(phase);
+  start = std::chrono::steady_clock::now();
+}
+
+Scope::~Scope() {
+  if (!outer) return;
+  auto time = std::chrono::steady_clock::now() - start;
+  auto i = static_cast<size_t>(phase);
+  active &= ~(1u << i);
+  ++local.calls[i];
+  local.time[i] += time;
+  if (auto s = sink.load(std::memory_order_acquire)) s(phase, time);
+}
+
+}  // namespace sqlpp::timing
@@ -0,0 +1,76 @@
+#ifndef SQLPP_TIMING_H_
+#define SQLPP_TIMING_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace sqlpp::timing {
+
+// Phases of a statement spent in the library (BUILD, RENDER, BIND, DECODE)
+// and in SQLite (PREPARE, STEP)
+enum class Phase {
+  BUILD,
+  RENDER,
+  PREPARE,
+  BIND,
+  STEP,
+  DECODE,
+};
+
+constexpr size_t PHASES = 6;
+
+// The hooks are compiled in only with SQLPP_TIMING defined, see the
+// SQLPP_TIMING CMake option
+#ifdef SQLPP_TIMING
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+const char* name(Phase phase);
+
+struct Counters {
+  std::array<uint64_t, PHASES> calls{};
+  std::array<std::chrono::nanoseconds, PHASES> time{};
+};
+
+// Counters of the calling thread
+const Counters& counters();
+void reset();
+
+// Called with every measured phase on the thread that ran it
+using Sink = void (*)(Phase phase, std::chrono::nanoseconds time);
+// nullptr removes the sink
+void setSink(Sink sink);
+
+// Measures its lifetime, a phase nested in the same phase (e.g. node clones)
+// is counted once
+class Scope {
+ public:
+  explicit Scope(Phase phase);
+  Scope(const Scope&) = delete;
+  ~Scope();
+
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  Phase phase;
+  bool outer;
+  std::chrono::steady_clock::time_point start;
+};
+
+}  // namespace sqlpp::timing
+
+#define SQLPP_TIMING_CONCAT_(A, B) A##B
+#define SQLPP_TIMING_SCOPE_(PHASE, LINE)                          \
+  ::sqlpp::timing::Scope SQLPP_TIMING_CONCAT_(sqlppTiming, LINE)( \
+      ::sqlpp::timing::Phase::PHASE)
+
+#ifdef SQLPP_TIMING
+#define SQLPP_TIME(PHASE) SQLPP_TIMING_SCOPE_(PHASE, __LINE__)
+#else
+#define SQLPP_TIME(PHASE) static_cast<void>(0)
+#endif
+
+#endif /* SQLPP_TIMING_H_ */
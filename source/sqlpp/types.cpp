@@ -2,23 +2,32 @@
 
 #include <sqlite3.h>
 
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 #include <stdexcept>
 
+#include "capture.h"
+
 namespace sqlpp {
 
 void bind(sqlite3_stmt* stmt, int idx, const Integer& value) {
+  if (capture::Recorder::active()) capture::Recorder::record(value);
   if (sqlite3_bind_int64(stmt, idx, value) != SQLITE_OK)
     throw std::runtime_error("Cannot bind integer parameter #" +
                              std::to_string(idx));
 }
 
 void bind(sqlite3_stmt* stmt, int idx, const Real& value) {
+  if (capture::Recorder::active()) capture::Recorder::record(value);
   if (sqlite3_bind_double(stmt, idx, value) != SQLITE_OK)
     throw std::runtime_error("Cannot bind real parameter #" +
                              std::to_string(idx));
 }
 
 void bind(sqlite3_stmt* stmt, int idx, const Text& value) {
+  if (capture::Recorder::active()) capture::Recorder::record(value);
   if (sqlite3_bind_text(stmt, idx, value.c_str(), -1, SQLITE_TRANSIENT) !=
       SQLITE_OK)
     throw std::runtime_error("Cannot bind text parameter #" +
@@ -26,10 +35,79 @@ void bind(sqlite3_stmt* stmt, int idx, const Text& value) {
 }
 
 void bind(sqlite3_stmt* stmt, int idx, const Blob& value) {
+  if (capture::Recorder::active()) capture::Recorder::record(value);
   if (sqlite3_bind_blob(stmt, idx, value.data(), value.size(),
                         SQLITE_TRANSIENT) != SQLITE_OK)
     throw std::runtime_error("Cannot bind BLOB parameter #" +
                              std::to_string(idx));
 }
 
+std::string literal(const Integer& value) { return std::to_string(value); }
+
+// SQL has no literal for NaN and infinities: NaN becomes NULL, as SQLite
+// stores it when bound, and infinities overflow to +/-Inf when parsed
+std::string literal(const Real& value) {
+  if (std::isnan(value)) return "NULL";
+  if (std::isinf(value)) return value > 0 ? "9e999" : "-9e999";
+  std::ostringstream ss;
+  ss << std::setprecision(std::numeric_limits<Real>::max_digits10) << value;
+  auto res = ss.str();
+  if (res.find_first_of(".eEn") == std::string::npos) res += ".0";
+  return res;
+}
+
+std::string literal(const Text& value) {
+  std::string res = "'";
+  for (char c : value) {
+    if (c == '\'') res += '\'';
+    res += c;
+  }
+  res += "'";
+  return res;
+}
+
+static const char HexDigits[] = "0123456789ABCDEF";
+
+std::string literal(const Blob& value) {
+  std::string res = "X'";
+  for (auto b : value) {
+    res += HexDigits[std::to_integer<int>(b) >> 4];
+    res += HexDigits[std::to_integer<int>(b) & 0xF];
+  }
+  res += "'";
+  return res;
+}
+
+void appendJson(std::string& json, const Integer& value) {
+  json += std::to_string(value);
+}
+
+void appendJson(std::string& json, const Real& value) {
+  // JSON spells the null literal in lower case
+  json += std::isnan(value) ? "null" : literal(value);
+}
+
+void appendJson(std::string& json, const Text& value) {
+  json += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        json += "\\\"";
+        break;
+      case '\\':
+        json += "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          json += "\\u00";
+          json += HexDigits[c >> 4];
+          json += HexDigits[c & 0xF];
+        } else {
+          json += c;
+        }
+    }
+  }
+  json += '"';
+}
+
 }  // namespace sqlpp
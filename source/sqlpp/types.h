@@ -6,6 +6,7 @@
 #include <functional>
 #include <string>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 struct sqlite3_stmt;
@@ -101,6 +102,20 @@ auto createBind(V&& value) {
   };
 }
 
+std::string literal(const Integer& value);
+std::string literal(const Real& value);
+std::string literal(const Text& value);
+std::string literal(const Blob& value);
+
+template <typename V>
+std::string createLiteral(const V& value) {
+  return literal(toDb(value));
+}
+
+void appendJson(std::string& json, const Integer& value);
+void appendJson(std::string& json, const Real& value);
+void appendJson(std::string& json, const Text& value);
+
 template <typename T>
 using TableType = typename T::TableType;
 
@@ -109,6 +124,10 @@ using ValueType = typename T::ValueType;
 
 namespace types {
 
+// The list operations below avoid peeling one element per instantiation: they
+// expand whole packs with fold expressions and index sequences, so the
+// instantiation depth stays flat for wide tables and long expression chains.
+
 template <typename... T>
 inline constexpr size_t PackSize = sizeof...(T);
 
@@ -147,6 +166,28 @@ struct TailS<List<T...>> {
 template <typename T>
 using Tail = typename TailS<T>::Type;
 
+template <size_t I, typename T>
+struct Indexed {
+  using Type = T;
+};
+
+template <typename S, typename... T>
+struct IndexedPack;
+
+template <size_t... I, typename... T>
+struct IndexedPack<std::index_sequence<I...>, T...> : Indexed<I, T>... {};
+
+// Only used in unevaluated context, overload resolution picks the one base
+// with the requested index.
+template <size_t I, typename T>
+Indexed<I, T> pickIndexed(const Indexed<I, T>&);
+
+#ifdef __has_builtin
+#if __has_builtin(__type_pack_element)
+#define SQLPP_TYPE_PACK_ELEMENT
+#endif
+#endif
+
 template <size_t I, typename L>
 struct GetS;
 
@@ -155,14 +196,21 @@ using Get = typename GetS<I, L>::Type;
 
 template <size_t I, typename... T>
 struct GetS<I, List<T...>> {
-  using Type = Get<I - 1, Tail<List<T...>>>;
+#ifdef SQLPP_TYPE_PACK_ELEMENT
+  using Type = __type_pack_element<I, T...>;
+#else
+  using Type = typename decltype(types::pickIndexed<I>(
+      std::declval<IndexedPack<std::index_sequence_for<T...>, T...>>()))::Type;
+#endif
 };
 
-template <typename... T>
-struct GetS<0, List<T...>> {
-  using Type = Head<List<T...>>;
-};
+#undef SQLPP_TYPE_PACK_ELEMENT
 
+template <typename U, typename... T>
+inline constexpr bool IsElement = (std::is_same_v<U, T> || ...);
+
+// Contains<U, L> is true if U is an element of L or, if U is a list, if all
+// its elements are in L.
 template <typename U, typename L>
 struct ContainsS;
 
@@ -171,19 +219,12 @@ inline constexpr bool Contains = ContainsS<U, L>::value;
 
 template <typename U, typename... T>
 struct ContainsS<U, List<T...>> {
-  static constexpr bool value =
-      (std::is_same_v<Head<U>, Head<List<T...>>> ||
-       Contains<Head<U>, Tail<List<T...>>>)&&Contains<Tail<U>, List<T...>>;
-};
-
-template <typename U>
-struct ContainsS<U, List<>> {
-  static constexpr bool value = false;
+  static constexpr bool value = IsElement<U, T...>;
 };
 
-template <typename... T>
-struct ContainsS<List<>, List<T...>> {
-  static constexpr bool value = true;
+template <typename... U, typename... T>
+struct ContainsS<List<U...>, List<T...>> {
+  static constexpr bool value = (IsElement<U, T...> && ...);
 };
 
 template <typename L>
@@ -194,12 +235,7 @@ inline constexpr size_t Size = SizeS<L>::value;
 
 template <typename... T>
 struct SizeS<List<T...>> {
-  static constexpr size_t value = 1 + Size<Tail<List<T...>>>;
-};
-
-template <>
-struct SizeS<List<>> {
-  static constexpr size_t value = 0;
+  static constexpr size_t value = sizeof...(T);
 };
 
 template <typename U, typename L>
@@ -225,45 +261,33 @@ struct InsertBackS<U, List<T...>> {
 };
 
 template <typename... T>
-struct MakeListS;
-
-template <typename... T>
-using MakeList = typename MakeListS<T...>::Type;
-
-template <typename T, typename... TT>
-struct MakeListS<T, TT...> {
-  using Type = Insert<T, MakeList<TT...>>;
-};
-
-template <>
-struct MakeListS<> {
-  using Type = List<>;
-};
+using MakeList = List<T...>;
 
+// Joins up to eight lists per step, filters produce one list per element so
+// the depth is an eighth of the element count.
 template <typename... L>
 struct ConcatS;
 
 template <typename... L>
 using Concat = typename ConcatS<L...>::Type;
 
-template <typename L1, typename L2, typename... LL>
-struct ConcatS<L1, L2, LL...> {
-  using Type = Concat<Concat<L1, L2>, LL...>;
-};
-
-template <typename L, typename T, typename... TT>
-struct ConcatS<L, List<T, TT...>> {
-  using Type = Concat<InsertBack<T, L>, List<TT...>>;
+template <typename... T>
+struct ConcatS<List<T...>> {
+  using Type = List<T...>;
 };
 
-template <typename L>
-struct ConcatS<L, List<>> {
-  using Type = L;
+template <typename... T1, typename... T2, typename... LL>
+struct ConcatS<List<T1...>, List<T2...>, LL...> {
+  using Type = Concat<List<T1..., T2...>, LL...>;
 };
 
-template <typename... T>
-struct ConcatS<List<T...>> {
-  using Type = List<T...>;
+template <typename... T1, typename... T2, typename... T3, typename... T4,
+          typename... T5, typename... T6, typename... T7, typename... T8,
+          typename... LL>
+struct ConcatS<List<T1...>, List<T2...>, List<T3...>, List<T4...>,
+               List<T5...>, List<T6...>, List<T7...>, List<T8...>, LL...> {
+  using Type = Concat<
+      List<T1..., T2..., T3..., T4..., T5..., T6..., T7..., T8...>, LL...>;
 };
 
 template <typename U, typename L>
@@ -276,75 +300,82 @@ template <typename U, typename... T>
 struct AddS<U, List<T...>> {
   using Type =
       std::conditional_t<Contains<U, List<T...>>, List<T...>, List<U, T...>>;
-  ;
 };
 
-template <typename... T>
-struct MakeSetS;
+// Prepends the elements of T that are not in L1 and that are not repeated
+// later in T, which gives the same order as adding them one by one from the
+// back.
+template <typename L1, typename S, typename... T>
+struct PrependNewS;
 
-template <typename... T>
-using MakeSet = typename MakeSetS<T...>::Type;
+template <typename... U, size_t... I, typename... T>
+struct PrependNewS<List<U...>, std::index_sequence<I...>, T...> {
+  template <size_t J, typename V>
+  static constexpr bool IS_NEW =
+      !IsElement<V, U...> && ((I <= J || !std::is_same_v<V, T>) && ...);
 
-template <typename T, typename... TT>
-struct MakeSetS<T, TT...> {
-  using Type = Add<T, MakeSet<TT...>>;
+  using Type = Concat<std::conditional_t<IS_NEW<I, T>, List<T>, List<>>...,
+                      List<U...>>;
 };
 
-template <>
-struct MakeSetS<> {
-  using Type = List<>;
+template <typename L1, typename L2>
+struct Merge2S;
+
+template <typename L1, typename L2>
+using Merge2 = typename Merge2S<L1, L2>::Type;
+
+template <typename L1, typename... T>
+struct Merge2S<L1, List<T...>> {
+  using Type =
+      typename PrependNewS<L1, std::index_sequence_for<T...>, T...>::Type;
 };
 
+template <typename... T>
+using MakeSet = Merge2<List<>, List<T...>>;
+
 template <typename... LL>
 struct MergeS;
 
 template <typename... LL>
 using Merge = typename MergeS<LL...>::Type;
 
-template <typename L1, typename L2>
-struct Merge2S;
-
-template <typename L1, typename L2>
-using Merge2 = typename Merge2S<L1, L2>::Type;
-
 template <typename L1, typename L2, typename... LL>
 struct MergeS<L1, L2, LL...> {
   using Type = Merge<Merge2<L1, L2>, LL...>;
 };
 
-template <typename L1, typename L2>
-struct MergeS<L1, L2> {
-  using Type = Merge2<L1, L2>;
-};
-
 template <typename L1>
 struct MergeS<L1> {
   using Type = L1;
 };
 
-template <typename L1, typename T, typename... TT>
-struct Merge2S<L1, List<T, TT...>> {
-  using Type = Add<T, Merge2<L1, List<TT...>>>;
-};
+template <typename L1, typename L2>
+struct SubtractS;
 
-template <typename L1>
-struct Merge2S<L1, List<>> {
-  using Type = L1;
+template <typename L1, typename L2>
+using Subtract = typename SubtractS<L1, L2>::Type;
+
+template <typename... T, typename L2>
+struct SubtractS<List<T...>, L2> {
+  using Type =
+      Concat<List<>,
+             std::conditional_t<Contains<T, L2>, List<>, List<T>>...>;
 };
 
-template <size_t... I>
-struct IntList;
+template <template <typename> typename F, typename L>
+struct MapS;
+
+template <template <typename> typename F, typename L>
+using Map = typename MapS<F, L>::Type;
 
-template <size_t I, size_t... II>
-struct IntList<I, II...> {
-  static constexpr bool contains(size_t j) {
-    return j == I || IntList<II...>::contains(j);
-  }
+template <template <typename> typename F, typename... T>
+struct MapS<F, List<T...>> {
+  using Type = List<F<T>...>;
 };
 
-template <>
-struct IntList<> {
-  static constexpr bool contains(size_t) { return false; }
+template <size_t... I>
+struct IntList {
+  static constexpr bool contains(size_t j) { return ((j == I) || ...); }
 };
 
 template <size_t J, typename L>
@@ -20,11 +20,21 @@ class AnotherTable final : public sqlpp::Table<AnotherTable, int, std::string> {
   Column<1> value = column<1>();
 };
 
+class NoKeyTable final : public sqlpp::Table<NoKeyTable, int> {
+ public:
+  static constexpr bool WITHOUT_ROWID = true;
+
+  NoKeyTable() : Table("NoKey", {"id"}) {}
+
+  Column<0> id = column<0>();
+};
+
 int main(int argc, char* argv[]) {
   sqlpp::Database db(":memory:");
 
   TestTable test;
   AnotherTable another;
+  NoKeyTable noKey;
 
   sqlpp::createTable(test).execute(db);
   sqlpp::createTableIfNotExists(another).execute(db);
@@ -64,5 +74,204 @@ int main(int argc, char* argv[]) {
       sqlpp::select(test).where(test.id == 0L && test.comment > test.value);
 #endif
 
+#ifdef CHECK_SELECT_JOIN_PASS
+  auto stmt = sqlpp::select(test.id, another.value)
+                  .join(another)
+                  .on(another.id == test.id)
+                  .where(test.value > 0.0 && another.value != "0"s);
+#endif
+
+#ifdef CHECK_SELECT_JOIN_MISSING_FAIL
+  auto stmt = sqlpp::select(test.id)
+                  .join(another)
+                  .on(another.id == test.id)
+                  .where(noKey.id > 0);
+#endif
+
+#ifdef CHECK_SELECT_JOIN_ORDER_FAIL
+  auto stmt = sqlpp::select(test.id)
+                  .join(another)
+                  .on(another.id == noKey.id)
+                  .join(noKey)
+                  .on(noKey.id == test.id);
+#endif
+
+#ifdef CHECK_SELECT_JOIN_CHAIN_PASS
+  auto stmt = sqlpp::select(test.id, another.value, noKey.id)
+                  .join(another)
+                  .on(another.id == test.id)
+                  .join(noKey)
+                  .on(noKey.id == another.id);
+  stmt.execute(db);
+#endif
+
+#ifdef CHECK_SELECT_JOIN_INCOMPLETE_FAIL
+  auto stmt = sqlpp::select(test.id, noKey.id)
+                  .join(another)
+                  .on(another.id == test.id);
+  stmt.execute(db);
+#endif
+
+#ifdef CHECK_ORDER_TERM_PASS
+  auto stmt = sqlpp::select(test.id).orderBy(sqlpp::desc(test.value), test.id);
+#endif
+
+#ifdef CHECK_ORDER_TERM_RESULT_FAIL
+  auto stmt = sqlpp::select(sqlpp::desc(test.id));
+#endif
+
+#ifdef CHECK_ORDER_TERM_COMPARE_FAIL
+  auto stmt = sqlpp::select(test.id).where(sqlpp::desc(test.id) == 1);
+#endif
+
+#ifdef CHECK_COMPOUND_PASS
+  auto stmt = sqlpp::select(test.id)
+                  .unionAll(sqlpp::select(another.id).where(another.id > 1))
+                  .limit(1);
+#endif
+
+#ifdef CHECK_COMPOUND_ORDER_FAIL
+  auto stmt = sqlpp::select(test.id).unionAll(
+      sqlpp::select(another.id).orderBy(another.id));
+#endif
+
+#ifdef CHECK_COMPOUND_LIMIT_FAIL
+  auto stmt =
+      sqlpp::select(test.id).unionAll(sqlpp::select(another.id).limit(1));
+#endif
+
+#ifdef CHECK_SUBQUERY_PASS
+  auto stmt = sqlpp::select(test.id).where(sqlpp::exists(
+      sqlpp::select(another.id).where(another.id == test.id), test));
+#endif
+
+#ifdef CHECK_SUBQUERY_OUTER_MISSING_FAIL
+  auto stmt = sqlpp::select(test.id).where(
+      sqlpp::exists(sqlpp::select(another.id).where(another.id == test.id)));
+#endif
+
+#ifdef CHECK_SUBQUERY_OUTER_UNUSED_FAIL
+  auto stmt = sqlpp::select(test.id).where(sqlpp::exists(
+      sqlpp::select(another.id).where(another.id > 1), test));
+#endif
+
+#ifdef CHECK_SELECT_NO_TABLE_FAIL
+  auto stmt = sqlpp::select(sqlpp::count());
+#endif
+
+#ifdef CHECK_RETURNING_PASS
+  auto stmt =
+      sqlpp::update(test.id = test.id + 1).returning(test.id, test.value);
+#endif
+
+#ifdef CHECK_RETURNING_FAIL
+  auto stmt =
+      sqlpp::update(test.id = test.id + 1).returning(test.id, another.id);
+#endif
+
+#ifdef CHECK_RETURNING_EXPRESSION_FAIL
+  auto stmt = sqlpp::update(test.id = test.id + 1)
+                  .returning(test.id + another.id);
+#endif
+
+#ifdef CHECK_UPSERT_PASS
+  auto stmt = sqlpp::insertInto(test)
+                  .values(1, std::string(), 0.0)
+                  .onConflict(test.id)
+                  .doUpdate(test.value = sqlpp::excluded(test.value));
+#endif
+
+#ifdef CHECK_UPSERT_FAIL
+  auto stmt = sqlpp::insertInto(test)
+                  .values(1, std::string(), 0.0)
+                  .onConflict(another.id)
+                  .doNothing();
+#endif
+
+#ifdef CHECK_UPSERT_WHERE_FAIL
+  auto stmt = sqlpp::insertInto(test)
+                  .values(1, std::string(), 0.0)
+                  .onConflict(test.id)
+                  .doUpdate(test.value = sqlpp::excluded(test.value))
+                  .where(another.id > 0);
+#endif
+
+#ifdef CHECK_DELETE_WHERE_PASS
+  auto stmt = sqlpp::deleteFrom(test).where(test.value > 0.0);
+#endif
+
+#ifdef CHECK_DELETE_WHERE_FAIL
+  auto stmt = sqlpp::deleteFrom(test).where(test.id == another.id);
+#endif
+
+#ifdef CHECK_INSERT_SELECT_PASS
+  auto stmt = sqlpp::insertInto(another).from(
+      sqlpp::select(test.id, test.comment).where(test.value > 0.0));
+#endif
+
+#ifdef CHECK_INSERT_SELECT_FAIL
+  auto stmt = sqlpp::insertInto(another).from(
+      sqlpp::select(test.comment, test.id).where(test.value > 0.0));
+#endif
+
+#ifdef CHECK_INSERT_SELECT_VALUES_FAIL
+  auto stmt = sqlpp::insertInto(another)
+                  .from(sqlpp::select(test.id, test.comment))
+                  .values(1, "1"s);
+#endif
+
+#ifdef CHECK_UPDATE_FROM_PASS
+  auto stmt = sqlpp::update(test.id = another.id)
+                  .from(another)
+                  .where(another.value == test.comment);
+#endif
+
+#ifdef CHECK_UPDATE_FROM_FAIL
+  auto stmt = sqlpp::update(test.id = another.id)
+                  .where(another.value == test.comment);
+#endif
+
+#ifdef CHECK_UPDATE_FROM_MISSING_FAIL
+  auto stmt = sqlpp::update(test.id = another.id);
+  stmt.execute(db);
+#endif
+
+#ifdef CHECK_UPDATE_FROM_RETURNING_FAIL
+  auto stmt = sqlpp::update(test.id = another.id).returning(test.id);
+#endif
+
+#ifdef CHECK_TYPELIST_PASS
+  using sqlpp::types::List;
+  static_assert(std::is_same_v<sqlpp::types::Get<2, List<int, char, double>>,
+                               double>);
+  static_assert(sqlpp::types::Contains<char, List<int, char>>);
+  static_assert(!sqlpp::types::Contains<char, List<>>);
+  static_assert(sqlpp::types::Contains<List<>, List<>>);
+  static_assert(sqlpp::types::Contains<List<int, char>, List<char, int>>);
+  static_assert(!sqlpp::types::Contains<List<int, long>, List<char, int>>);
+  static_assert(sqlpp::types::Size<List<int, int, char>> == 3);
+  static_assert(
+      std::is_same_v<sqlpp::types::Concat<List<int>, List<>, List<char>,
+                                          List<int>, List<>, List<>, List<>,
+                                          List<>, List<double>, List<long>>,
+                     List<int, char, int, double, long>>);
+  static_assert(std::is_same_v<sqlpp::types::MakeSet<int, char, int>,
+                               List<char, int>>);
+  static_assert(
+      std::is_same_v<
+          sqlpp::types::Merge<List<int>, List<char, int, double, char>>,
+          List<double, char, int>>);
+  static_assert(
+      std::is_same_v<sqlpp::types::Subtract<List<int, char, long>, List<char>>,
+                     List<int, long>>);
+  static_assert(sqlpp::types::IntList<3, 1>::contains(1));
+  static_assert(!sqlpp::types::IntList<>::contains(0));
+  auto stmt = sqlpp::select(test.id);
+#endif
+
+#ifdef CHECK_WITHOUT_ROWID_KEY_FAIL
+  auto stmt = sqlpp::createTable(noKey);
+#endif
+
   return 0;
 }
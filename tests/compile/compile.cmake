@@ -31,3 +31,35 @@ add_type_test(check_insert_values_twice_fail CHECK_INSERT_VALUES_TWICE_FAIL TRUE
 add_type_test(check_insert_two_tables_fail CHECK_INSERT_TWO_TABLES_FAIL TRUE)
 add_type_test(check_select_condition_pass CHECK_SELECT_CONDITION_PASS TRUE)
 add_type_test(check_select_condition_fail CHECK_SELECT_CONDITION_FAIL TRUE)
+add_type_test(check_without_rowid_key_fail CHECK_WITHOUT_ROWID_KEY_FAIL TRUE)
+add_type_test(check_select_join_pass CHECK_SELECT_JOIN_PASS FALSE)
+add_type_test(check_select_join_missing_fail CHECK_SELECT_JOIN_MISSING_FAIL TRUE)
+add_type_test(check_select_join_order_fail CHECK_SELECT_JOIN_ORDER_FAIL TRUE)
+add_type_test(check_select_join_chain_pass CHECK_SELECT_JOIN_CHAIN_PASS FALSE)
+add_type_test(check_select_join_incomplete_fail CHECK_SELECT_JOIN_INCOMPLETE_FAIL TRUE)
+add_type_test(check_order_term_pass CHECK_ORDER_TERM_PASS FALSE)
+add_type_test(check_order_term_result_fail CHECK_ORDER_TERM_RESULT_FAIL TRUE)
+add_type_test(check_order_term_compare_fail CHECK_ORDER_TERM_COMPARE_FAIL TRUE)
+add_type_test(check_compound_pass CHECK_COMPOUND_PASS FALSE)
+add_type_test(check_compound_order_fail CHECK_COMPOUND_ORDER_FAIL TRUE)
+add_type_test(check_compound_limit_fail CHECK_COMPOUND_LIMIT_FAIL TRUE)
+add_type_test(check_subquery_pass CHECK_SUBQUERY_PASS FALSE)
+add_type_test(check_subquery_outer_missing_fail CHECK_SUBQUERY_OUTER_MISSING_FAIL TRUE)
+add_type_test(check_subquery_outer_unused_fail CHECK_SUBQUERY_OUTER_UNUSED_FAIL TRUE)
+add_type_test(check_select_no_table_fail CHECK_SELECT_NO_TABLE_FAIL TRUE)
+add_type_test(check_returning_pass CHECK_RETURNING_PASS FALSE)
+add_type_test(check_returning_fail CHECK_RETURNING_FAIL TRUE)
+add_type_test(check_returning_expression_fail CHECK_RETURNING_EXPRESSION_FAIL TRUE)
+add_type_test(check_upsert_pass CHECK_UPSERT_PASS FALSE)
+add_type_test(check_upsert_fail CHECK_UPSERT_FAIL TRUE)
+add_type_test(check_upsert_where_fail CHECK_UPSERT_WHERE_FAIL TRUE)
+add_type_test(check_delete_where_pass CHECK_DELETE_WHERE_PASS FALSE)
+add_type_test(check_delete_where_fail CHECK_DELETE_WHERE_FAIL TRUE)
+add_type_test(check_insert_select_pass CHECK_INSERT_SELECT_PASS FALSE)
+add_type_test(check_insert_select_fail CHECK_INSERT_SELECT_FAIL TRUE)
+add_type_test(check_insert_select_values_fail CHECK_INSERT_SELECT_VALUES_FAIL TRUE)
+add_type_test(check_update_from_pass CHECK_UPDATE_FROM_PASS FALSE)
+add_type_test(check_update_from_fail CHECK_UPDATE_FROM_FAIL TRUE)
+add_type_test(check_update_from_missing_fail CHECK_UPDATE_FROM_MISSING_FAIL TRUE)
+add_type_test(check_update_from_returning_fail CHECK_UPDATE_FROM_RETURNING_FAIL TRUE)
+add_type_test(check_typelist_pass CHECK_TYPELIST_PASS FALSE)
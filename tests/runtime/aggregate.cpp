@@ -0,0 +1,92 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Sale final : public Table<Sale, int, std::string, int, double> {
+ public:
+  Sale() : Table("Sale", {"id", "region", "amount", "price"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> region = column<1>();
+  Column<2> amount = column<2>();
+  Column<3> price = column<3>();
+};
+
+class Region final : public Table<Region, std::string> {
+ public:
+  Region() : Table("Region", {"name"}) {}
+
+  Column<0> name = column<0>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Sale sale;
+  Region region;
+
+  createTable(sale).execute(db);
+  createTable(region).execute(db);
+
+  insertInto(sale).values(1, "north"s, 3, 1.5).execute(db);
+  insertInto(sale).values(2, "north"s, 5, 2.5).execute(db);
+  insertInto(sale).values(3, "south"s, 7, 1.0).execute(db);
+  insertInto(region).values("north"s).execute(db);
+
+  auto total = select(count(), sum(sale.amount), max(sale.price),
+                      countDistinct(sale.region))
+                   .executeT(db);
+  static_assert(std::is_same_v<decltype(total.get<1>()),
+                               std::optional<Integer>>);
+  if (total.get<0>().value() != 3 || total.get<1>().value() != 15 ||
+      total.get<2>().value() != 2.5 || total.get<3>().value() != 2)
+    throw std::runtime_error("Unexpected aggregate values");
+
+  auto all = select(count(sale));
+  check(all, "SELECT count(*) FROM Sale");
+  if (all.executeT(db).get<0>().value() != 3)
+    throw std::runtime_error("Unexpected table row count");
+
+  auto stmt = select(sale.region, count(sale.id), avg(sale.price * 2.0),
+                     min(sale.amount))
+                  .where(sale.id > 0)
+                  .groupBy(sale.region)
+                  .orderBy(sale.region);
+  check(stmt,
+        "SELECT Sale.region, count(Sale.id), avg(Sale.price * ?), "
+        "min(Sale.amount) FROM Sale WHERE Sale.id > ? GROUP BY Sale.region "
+        "ORDER BY Sale.region");
+
+  auto res = stmt.executeT(db);
+  if (!res.hasData() || res.get<0>().value() != "north" ||
+      res.get<1>().value() != 2 || res.get<2>().value() != 4.0 ||
+      res.get<3>().value() != 3)
+    throw std::runtime_error("Unexpected group values");
+  res.next();
+  if (!res.hasData() || res.get<0>().value() != "south" ||
+      res.get<2>().value() != 2.0)
+    throw std::runtime_error("Unexpected group values");
+
+  auto stmt2 = select(sale.id).where(
+      exists(select(region.name).where(region.name == "north"s)) &&
+      sale.amount > 4);
+  check(stmt2,
+        "SELECT Sale.id FROM Sale WHERE EXISTS (SELECT Region.name FROM Region "
+        "WHERE Region.name = ?) AND Sale.amount > ?");
+  auto res2 = stmt2.executeT(db);
+  size_t rows = 0;
+  for (; res2.hasData(); res2.next()) ++rows;
+  if (rows != 2) throw std::runtime_error("Unexpected exists row count");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,111 @@
+#include <sqlpp.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+// Counts the C++ heap allocations of the process, SQLite itself allocates
+// with malloc and is not counted
+static std::atomic<size_t> allocations = 0;
+
+void* operator new(size_t size) {
+  ++allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  ++allocations;
+  return std::malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+  return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+
+class MyTable final : public Table<MyTable, int, std::string> {
+ public:
+  MyTable() : Table("MyTable", {"id", "text"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> text = column<1>();
+};
+
+// Fails when the code allocates more than the limit. The limits are the
+// current counts with a little headroom for standard library differences,
+// lower them when an optimization lands.
+template <typename F>
+static void checkAllocations(const std::string& name, size_t limit, F&& f) {
+  size_t start = allocations;
+  f();
+  size_t count = allocations - start;
+  std::cout << name << ": " << count << " allocations (limit " << limit
+            << ")" << std::endl;
+  if (count > limit)
+    throw std::runtime_error("Too many allocations in " + name);
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  MyTable mt;
+  createTable(mt).execute(db);
+  insertInto(mt).values(1, "First"s).execute(db);
+  insertInto(mt).values(2, std::string(100, 'x')).execute(db);
+
+  checkAllocations("build insert", 4, [&] {
+    auto stmt = insertInto(mt).values(10, "Hi"s);
+  });
+  auto insert = insertInto(mt).values(10, "Hi"s);
+  checkAllocations("copy insert", 3, [&] { auto copy = insert; });
+  checkAllocations("execute insert", 3, [&] { insert.execute(db); });
+  checkAllocations("insert lifecycle", 6, [&] {
+    insertInto(mt).values(10, "Hi"s).execute(db);
+  });
+
+  checkAllocations("build select", 24, [&] {
+    auto stmt = select(mt.text).where(mt.id > 5 && mt.text != "x"s);
+  });
+  auto base = select(mt.id, mt.text);
+  checkAllocations("const& where", 12, [&] {
+    auto stmt = base.where(mt.id > 5);
+  });
+  auto query = select(mt.id, mt.text).where(mt.id == 1);
+  checkAllocations("copy select", 8, [&] { auto copy = query; });
+  checkAllocations("execute select", 4, [&] {
+    auto res = query.executeT(db);
+  });
+
+  auto res = query.executeT(db);
+  checkAllocations("decode row", 0, [&] {
+    auto id = res.get<0>();
+    auto text = res.get<1>();
+    if (id != 1 || text != "First")
+      throw std::runtime_error("Unexpected decoded row");
+  });
+  // One allocation for the text beyond the small string buffer
+  auto longRes = select(mt.text).where(mt.id == 2).executeT(db);
+  checkAllocations("decode long text", 1, [&] {
+    auto text = longRes.get<0>();
+    if (!text || text->size() != 100)
+      throw std::runtime_error("Unexpected decoded long text");
+  });
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,77 @@
+#include <sqlpp.h>
+
+#include <filesystem>
+#include <iostream>
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Note final : public Table<Note, int, std::string, double, Blob> {
+ public:
+  Note() : Table("Notes", {"id", "text", "score", "data"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> text = column<1>();
+  Column<2> score = column<2>();
+  Column<3> data = column<3>();
+};
+
+int main(int argc, char* argv[]) try {
+  auto path =
+      (std::filesystem::temp_directory_path() / "sqlpp_capture_test.log")
+          .string();
+  Note n;
+  Blob blob{std::byte{0}, std::byte{0xff}};
+  {
+    Database db(":memory:");
+    createTable(n).execute(db);
+    db.startCapture(path);
+    insertInto(n).values(-5, "it's"s, 0.25, blob).execute(db);
+    insertInto(n).values(300, "x"s, -1.5, Blob()).execute(db);
+    select(n.text).where(n.id > -10 && n.score < 1.0).execute(db);
+    select(n.text).where(n.id > 7 && n.score < 2.0).execute(db);
+    db.stopCapture();
+    select(n.text).execute(db);
+  }
+
+  capture::Reader reader(path);
+  std::vector<capture::Statement> log;
+  for (capture::Statement s; reader.next(s);) log.push_back(s);
+  std::filesystem::remove(path);
+
+  for (const auto& s : log) std::cout << s.sql << std::endl;
+  if (log.size() != 4) throw std::runtime_error("Unexpected statement count");
+  if (log[0].sql != "INSERT INTO Notes VALUES (?, ?, ?, ?)" ||
+      log[0].binds !=
+          std::vector<capture::Value>{Integer(-5), "it's"s, 0.25, blob} ||
+      log[1].binds !=
+          std::vector<capture::Value>{Integer(300), "x"s, -1.5, Blob()})
+    throw std::runtime_error("Unexpected insert capture");
+  if (log[2].fingerprint != log[3].fingerprint ||
+      log[3].binds != std::vector<capture::Value>{Integer(7), 2.0})
+    throw std::runtime_error("Unexpected select capture");
+  for (size_t i = 0; i < log.size(); ++i)
+    if (!log[i].ok || log[i].time.count() <= 0 ||
+        (i > 0 && log[i].start < log[i - 1].start))
+      throw std::runtime_error("Unexpected capture timing");
+
+  // Replaying the log gives the same rows
+  Database db(":memory:");
+  createTable(n).execute(db);
+  for (const auto& s : log) {
+    std::vector<Bind> binds;
+    for (const auto& v : s.binds) binds.push_back(capture::createBind(v));
+    db.execute(s.sql, binds);
+  }
+  auto res = select(n.data).where(n.id == -5).executeT(db);
+  if (!res.hasData() || res.get<0>().value() != blob)
+    throw std::runtime_error("Unexpected replayed row");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
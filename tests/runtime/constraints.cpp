@@ -0,0 +1,94 @@
+#include <sqlpp.h>
+
+#include <iostream>
+#include <limits>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class KeyTable final : public Table<KeyTable, int, std::string> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0>;
+  static constexpr bool STRICT = true;
+
+  KeyTable() : Table("KeyTable", {"id", "name"}) {
+    setNotNull<1>();
+    setDefault<1>("it's unknown"s);
+  }
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+};
+
+class PairTable final : public Table<PairTable, int, std::string, double> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<1, 0>;
+  static constexpr bool WITHOUT_ROWID = true;
+  static constexpr bool STRICT = true;
+
+  PairTable() : Table("PairTable", {"id", "name", "value"}) {
+    setDefault<2>(0.5);
+  }
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> value = column<2>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  KeyTable kt;
+  PairTable pt;
+
+  static_assert(PrimaryKeyType<KeyTable>::contains(0));
+  static_assert(!PrimaryKeyType<PairTable>::contains(2));
+
+  auto ktStmt = createTable(kt);
+  check(ktStmt,
+        "CREATE TABLE KeyTable (id INTEGER PRIMARY KEY, name TEXT NOT NULL "
+        "DEFAULT 'it''s unknown') STRICT");
+  ktStmt.execute(db);
+
+  auto ptStmt = createTable(pt);
+  check(ptStmt,
+        "CREATE TABLE PairTable (id INTEGER, name TEXT, value REAL DEFAULT "
+        "0.5, PRIMARY KEY (name, id)) WITHOUT ROWID, STRICT");
+  ptStmt.execute(db);
+
+  insertValues(kt.id <<= 5).execute(db);
+  if (insertValues(kt.id <<= 5).execute(db))
+    throw std::runtime_error("Duplicate key is accepted");
+
+  auto res = select(kt).where(kt.id == 5).executeT(db);
+  if (!res.hasData() || res.get<1>().value() != "it's unknown")
+    throw std::runtime_error("Default value is not applied");
+
+  insertInto(pt).values(1, "a"s, 1.0).execute(db);
+  insertValues(pt.id <<= 1, pt.name <<= "b"s).execute(db);
+  if (insertInto(pt).values(1, "a"s, 2.0).execute(db))
+    throw std::runtime_error("Duplicate composite key is accepted");
+
+  auto res2 = select(pt.value).where(pt.name == "b"s).executeT(db);
+  if (!res2.hasData() || res2.get<0>().value() != 0.5)
+    throw std::runtime_error("Default value is not applied");
+
+  if (literal(std::numeric_limits<Real>::infinity()) != "9e999" ||
+      literal(-std::numeric_limits<Real>::infinity()) != "-9e999" ||
+      literal(std::numeric_limits<Real>::quiet_NaN()) != "NULL")
+    throw std::runtime_error("Unexpected literal for a special value");
+
+  auto res3 = db.execute("SELECT 9e999 > 1e308, -9e999 < -1e308");
+  if (!res3.hasData() || !res3.as<Integer>(0).value() ||
+      !res3.as<Integer>(1).value())
+    throw std::runtime_error("Infinity literal is not parsed as infinity");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
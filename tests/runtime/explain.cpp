@@ -0,0 +1,84 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "plan_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class User final : public Table<User, int, std::string, int> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0>;
+
+  User() : Table("Users", {"id", "name", "age"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> age = column<2>();
+};
+
+class Login final : public Table<Login, int, int, std::string> {
+ public:
+  Login() : Table("Logins", {"id", "user", "time"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> user = column<1>();
+  Column<2> time = column<2>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  User u;
+  Login l;
+
+  createTable(u).execute(db);
+  createTable(l).execute(db);
+  db.execute("CREATE INDEX users_name ON Users(name)");
+
+  checkPlan(db, select(u).where(u.id == 1),
+            "SEARCH Users USING INTEGER PRIMARY KEY");
+  checkPlan(db, select(u.id).where(u.name == "ann"s),
+            "SEARCH Users USING COVERING INDEX users_name");
+  checkPlan(db, select(u).where(u.age > 30).orderBy(u.age),
+            "SCAN Users\n"
+            "USE TEMP B-TREE FOR ORDER BY");
+  checkPlan(db, select(u.age, count(u.id)).groupBy(u.age),
+            "SCAN Users\n"
+            "USE TEMP B-TREE FOR GROUP BY");
+
+  auto plan = select(u).where(u.name == "ann"s).explain(db);
+  if (plan.scans("Users") || !plan.usesIndex("users_name") ||
+      plan.usesTempBTree())
+    throw std::runtime_error("Unexpected index plan");
+  const auto& node = plan.nodes().at(0);
+  if (node.kind != PlanNode::Kind::Search || node.table != "Users" ||
+      node.covering || node.detail != "SEARCH Users USING INDEX users_name "
+                                      "(name=?)")
+    throw std::runtime_error("Unexpected plan node");
+
+  // A schema change turns the lookup into a scan
+  auto lookup = select(l.time).where(l.user == 1);
+  db.execute("CREATE INDEX logins_user ON Logins(user)");
+  checkNoScan(db, lookup, "Logins");
+  db.execute("DROP INDEX logins_user");
+  if (!lookup.explain(db).scans("Logins"))
+    throw std::runtime_error("Scan is not detected");
+
+  checkPlan(db, update(u.age = u.age + 1).where(u.name == "bob"s),
+            "SEARCH Users USING INDEX users_name");
+  checkPlan(db, deleteFrom(u).where(u.age < 10), "SCAN Users");
+  checkPlan(db,
+            select(u.name, l.time).join(l).on(l.user == u.id).where(
+                u.id == 2),
+            "SEARCH Users USING INTEGER PRIMARY KEY\n"
+            "SCAN Logins");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
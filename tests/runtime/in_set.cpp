@@ -0,0 +1,99 @@
+#include <sqlpp.h>
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <list>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Item final : public Table<Item, int, std::string, double> {
+ public:
+  Item() : Table("Item", {"id", "name", "value"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> value = column<2>();
+};
+
+class Tag final : public Table<Tag, int, std::string> {
+ public:
+  Tag() : Table("Tag", {"item", "tag"}) {}
+
+  Column<0> item = column<0>();
+  Column<1> tag = column<1>();
+};
+
+template <typename R>
+static size_t countRows(R&& res) {
+  size_t n = 0;
+  for (; res.hasData(); res.next()) ++n;
+  return n;
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Item item;
+  Tag tag;
+
+  createTable(item).execute(db);
+  createTable(tag).execute(db);
+
+  for (int i = 0; i < 100; ++i) {
+    insertInto(item)
+        .values(i, "item \"" + std::to_string(i) + "\"", i / 4.0)
+        .execute(db);
+    if (i % 10 == 0) insertInto(tag).values(i, "tenth"s).execute(db);
+  }
+
+  std::vector<int> ids;
+  for (int i = 0; i < 5000; i += 2) ids.push_back(i);
+
+  auto stmt = select(item.id).where(item.id.in(ids));
+  check(stmt,
+        "SELECT Item.id FROM Item WHERE Item.id IN (SELECT value FROM "
+        "json_each(?))");
+  if (countRows(stmt.executeT(db)) != 50)
+    throw std::runtime_error("Unexpected integer set row count");
+
+  std::list<std::string> names = {"item \"3\"", "item \"7\"", "none"};
+  if (countRows(select(item.id).where(item.name.in(names)).executeT(db)) != 2)
+    throw std::runtime_error("Unexpected text set row count");
+
+  std::vector<double> values = {0.25, 1.0 / 3, 2.5};
+  if (countRows(select(item.id).where(item.value.in(values)).executeT(db)) !=
+      2)
+    throw std::runtime_error("Unexpected real set row count");
+
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  insertInto(item).values(100, "infinite"s, INF).execute(db);
+  std::vector<double> special = {INF, std::nan(""), 2.5};
+  if (countRows(select(item.id).where(item.value.in(special)).executeT(db)) !=
+      2)
+    throw std::runtime_error("Unexpected special real set row count");
+
+  if (countRows(select(item.id)
+                    .where(item.id.in(std::vector<int>()))
+                    .executeT(db)) != 0)
+    throw std::runtime_error("Unexpected empty set row count");
+
+  auto stmt2 = select(item.name).where(
+      item.id.in(select(tag.item).where(tag.tag == "tenth"s)) &&
+      item.id > 40);
+  check(stmt2,
+        "SELECT Item.name FROM Item WHERE Item.id IN (SELECT Tag.item FROM Tag "
+        "WHERE Tag.tag = ?) AND Item.id > ?");
+  if (countRows(stmt2.executeT(db)) != 5)
+    throw std::runtime_error("Unexpected subquery row count");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
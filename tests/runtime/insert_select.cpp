@@ -0,0 +1,89 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Staging final : public Table<Staging, int, std::string, double> {
+ public:
+  Staging() : Table("Staging", {"id", "name", "price"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> price = column<2>();
+};
+
+class Product final : public Table<Product, int, std::string, double> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0>;
+
+  Product() : Table("Product", {"id", "name", "price"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> price = column<2>();
+};
+
+class Total final : public Table<Total, std::string, double> {
+ public:
+  Total() : Table("Total", {"name", "sum"}) {}
+
+  Column<0> name = column<0>();
+  Column<1> sum = column<1>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Staging st;
+  Product pr;
+  Total tt;
+
+  createTable(st).execute(db);
+  createTable(pr).execute(db);
+  createTable(tt).execute(db);
+  insertInto(st).values(1, "a"s, 1.5).execute(db);
+  insertInto(st).values(2, "b"s, 2.5).execute(db);
+  insertInto(st).values(3, "a"s, 3.0).execute(db);
+
+  auto copy = insertInto(pr).from(select(st).where(st.price > 2.0));
+  check(copy,
+        "INSERT INTO Product SELECT Staging.* FROM Staging WHERE "
+        "Staging.price > ?");
+  if (!copy.execute(db)) throw std::runtime_error("Rows are not copied");
+
+  auto res = select(count(pr.id)).executeT(db);
+  if (res.get<0>().value() != 2)
+    throw std::runtime_error("Unexpected copied rows count");
+
+  auto merge = insertInto(pr).from(select(st)).onConflict(pr.id).doNothing();
+  check(merge,
+        "INSERT INTO Product SELECT * FROM (SELECT Staging.* FROM Staging) "
+        "WHERE true ON CONFLICT (id) DO NOTHING");
+  if (!merge.execute(db) ||
+      select(count(pr.id)).executeT(db).get<0>().value() != 3)
+    throw std::runtime_error("Unexpected merged rows count");
+
+  auto totals = insertInto(tt)
+                    .from(select(st.name, sum(st.price * 2.0))
+                              .groupBy(st.name)
+                              .orderBy(st.name))
+                    .returning(tt.sum);
+  check(totals,
+        "INSERT INTO Total SELECT Staging.name, sum(Staging.price * ?) FROM "
+        "Staging GROUP BY Staging.name ORDER BY Staging.name RETURNING "
+        "Total.sum");
+  auto sums = totals.executeT(db);
+  if (!sums.hasData() || sums.get<0>().value() != 9.0)
+    throw std::runtime_error("Unexpected total");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,94 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Person final : public Table<Person, int, std::string> {
+ public:
+  Person() : Table("Person", {"id", "name"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+};
+
+class Phone final : public Table<Phone, int, std::string> {
+ public:
+  Phone() : Table("Phone", {"person", "number"}) {}
+
+  Column<0> person = column<0>();
+  Column<1> number = column<1>();
+};
+
+class Note final : public Table<Note, int, std::string> {
+ public:
+  Note() : Table("Note", {"person", "text"}) {}
+
+  Column<0> person = column<0>();
+  Column<1> text = column<1>();
+};
+
+template <typename R>
+static size_t countRows(R&& res) {
+  size_t n = 0;
+  for (; res.hasData(); res.next()) ++n;
+  return n;
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Person person;
+  Phone phone;
+  Note note;
+
+  createTable(person).execute(db);
+  createTable(phone).execute(db);
+  createTable(note).execute(db);
+
+  insertInto(person).values(1, "Ann"s).execute(db);
+  insertInto(person).values(2, "Bob"s).execute(db);
+  insertInto(phone).values(1, "123"s).execute(db);
+  insertInto(phone).values(1, "456"s).execute(db);
+  insertInto(note).values(2, "Busy"s).execute(db);
+
+  auto stmt = select(person.name, phone.number)
+                  .join(phone)
+                  .on(phone.person == person.id)
+                  .where(person.id > 0);
+  check(stmt,
+        "SELECT Person.name, Phone.number FROM Person JOIN Phone ON "
+        "Phone.person = Person.id WHERE Person.id > ?");
+  if (countRows(stmt.executeT(db)) != 2)
+    throw std::runtime_error("Unexpected inner join row count");
+
+  auto stmt2 = select(person.name, phone.number, note.text)
+                   .leftJoin(phone)
+                   .on(phone.person == person.id)
+                   .leftJoin(note)
+                   .on(note.person == person.id && note.text != "Idle"s)
+                   .orderBy(person.id);
+  check(stmt2,
+        "SELECT Person.name, Phone.number, Note.text FROM Person LEFT JOIN "
+        "Phone ON Phone.person = Person.id LEFT JOIN Note ON Note.person = "
+        "Person.id AND Note.text <> ? ORDER BY Person.id");
+
+  auto res = stmt2.executeT(db);
+  size_t rows = 0;
+  for (; res.hasData(); res.next(), ++rows) {
+    if (res.get<0>().value() == "Bob" &&
+        (res.get<1>() || res.get<2>().value_or("") != "Busy"))
+      throw std::runtime_error("Unexpected left join row");
+  }
+  if (rows != 3) throw std::runtime_error("Unexpected left join row count");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
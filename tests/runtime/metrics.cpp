@@ -0,0 +1,68 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Entry final : public Table<Entry, int, std::string> {
+ public:
+  Entry() : Table("Entries", {"id", "text"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> text = column<1>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Entry e;
+  createTable(e).execute(db);
+
+  db.execute("BEGIN");
+  for (int i = 0; i < 500; ++i)
+    insertInto(e).values(i, std::string(100, 'a' + i % 26)).execute(db);
+  db.execute("COMMIT");
+  auto res = select(e.text).where(e.id > 100).execute(db);
+  while (res.hasData()) res.next();
+
+  auto metrics = db.metrics(true);
+  for (const auto& [name, value] : metrics)
+    std::cout << name << " = " << value << std::endl;
+
+  for (auto name : {"cache.hit", "cache.used", "schema.used",
+                    "process.memory_used", "process.malloc_count"})
+    if (metrics.at(name) <= 0)
+      throw std::runtime_error("Unexpected metric "s + name);
+  if (metrics.at("process.memory_used.highwater") <
+      metrics.at("process.memory_used"))
+    throw std::runtime_error("High-water mark is below the current value");
+  if (!metrics.contains("lookaside.used.highwater") ||
+      !metrics.contains("cache.spill") || !metrics.contains("stmt.used"))
+    throw std::runtime_error("Missing metrics");
+
+  // Counters start from zero after a reset, the process high-water marks
+  // are only reset explicitly
+  {
+    Database peak(":memory:");
+    peak.execute("CREATE TABLE Big (data BLOB)");
+    peak.execute("INSERT INTO Big VALUES (zeroblob(8000000))");
+  }
+  auto highwater = db.metrics().at("process.memory_used.highwater");
+  db.metrics(true);
+  auto after = db.metrics();
+  if (after.at("cache.hit") != 0)
+    throw std::runtime_error("Cache counters are not reset");
+  if (after.at("process.memory_used.highwater") < highwater)
+    throw std::runtime_error("Process high-water mark is reset");
+  Database::resetProcessMetrics();
+  if (db.metrics().at("process.memory_used.highwater") >= highwater)
+    throw std::runtime_error("Process high-water mark is not reset");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,80 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Item final : public Table<Item, int, int, std::string> {
+ public:
+  Item() : Table("Item", {"id", "grp", "name"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> grp = column<1>();
+  Column<2> name = column<2>();
+};
+
+template <typename P>
+static std::vector<int> readAll(P& pager, const Database& db) {
+  std::vector<int> ids;
+  while (true) {
+    auto res = pager.page().executeT(db);
+    size_t rows = 0;
+    for (; res.hasData(); res.next(), ++rows) {
+      ids.push_back(res.template get<0>().value());
+      pager.remember(res);
+    }
+    if (rows < 3) break;
+  }
+  return ids;
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Item item;
+
+  createTable(item).execute(db);
+  for (int i = 0; i < 10; ++i)
+    insertInto(item).values(i, i % 3, "item" + std::to_string(i)).execute(db);
+
+  auto pager = select(item.id, item.name).where(item.id > 0).pageBy(
+      3, item.grp, item.id);
+  check(pager.page(),
+        "SELECT Item.id, Item.name, Item.grp, Item.id FROM Item WHERE Item.id "
+        "> ? ORDER BY Item.grp ASC, Item.id ASC LIMIT 3");
+
+  auto ids = readAll(pager, db);
+  if (ids != std::vector<int>{3, 6, 9, 1, 4, 7, 2, 5, 8})
+    throw std::runtime_error("Unexpected ascending page order");
+
+  pager.seek(1, 4);
+  check(pager.page(),
+        "SELECT Item.id, Item.name, Item.grp, Item.id FROM Item WHERE Item.id "
+        "> ? AND (Item.grp, Item.id) > (?, ?) ORDER BY Item.grp ASC, Item.id "
+        "ASC LIMIT 3");
+  auto res = pager.page().executeT(db);
+  if (!res.hasData() || res.get<0>().value() != 7)
+    throw std::runtime_error("Unexpected seek result");
+
+  auto descPager = select(item.id).pageBy(3, Order::DESC, item.id);
+  if (readAll(descPager, db) !=
+      std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0})
+    throw std::runtime_error("Unexpected descending page order");
+
+  auto stmt = select(item.id).orderBy(desc(item.grp), asc(item.id)).limit(2);
+  check(stmt,
+        "SELECT Item.id FROM Item ORDER BY Item.grp DESC, Item.id ASC LIMIT 2");
+  auto res2 = stmt.executeT(db);
+  if (!res2.hasData() || res2.get<0>().value() != 2)
+    throw std::runtime_error("Unexpected descending order");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,31 @@
+#ifndef TESTS_RUNTIME_PLAN_CHECK_H_
+#define TESTS_RUNTIME_PLAN_CHECK_H_
+
+#include <sqlpp.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+// Fails when the query plan of the statement differs from the expected
+// shape, see Plan::shape() for the format
+inline void checkPlan(const sqlpp::Database& db, const sqlpp::Statement& stmt,
+                      const std::string& expected) {
+  auto shape = stmt.explain(db).shape();
+  std::cout << stmt << "\n" << shape << std::endl;
+  if (shape != expected)
+    throw std::runtime_error("Unexpected query plan:\n" + shape +
+                             "\nexpected:\n" + expected);
+}
+
+// Fails when the statement reads the table with a full scan
+inline void checkNoScan(const sqlpp::Database& db,
+                        const sqlpp::Statement& stmt,
+                        const std::string& table) {
+  auto plan = stmt.explain(db);
+  if (plan.scans(table))
+    throw std::runtime_error("Unexpected scan of " + table + ":\n" +
+                             plan.shape());
+}
+
+#endif /* TESTS_RUNTIME_PLAN_CHECK_H_ */
@@ -0,0 +1,95 @@
+#include <sqlpp.h>
+
+#include <iostream>
+#include <sstream>
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Item final : public Table<Item, int, std::string, double> {
+ public:
+  Item() : Table("Items", {"id", "name", "price"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> price = column<2>();
+};
+
+static void expect(const std::string& value, const std::string& expected) {
+  std::cout << value << std::endl;
+  if (value != expected)
+    throw std::runtime_error("Unexpected value, expected: " + expected);
+}
+
+int main(int argc, char* argv[]) try {
+  expect(fingerprint("SELECT  a FROM t1\n WHERE b = 'it''s' AND c > 1.5e3"),
+         "SELECT a FROM t1 WHERE b = ? AND c > ?");
+  expect(fingerprint("SELECT \"col 1\" FROM t WHERE x IN (?, ?, ?, 7)"),
+         "SELECT \"col 1\" FROM t WHERE x IN (?)");
+  expect(fingerprint("INSERT INTO t VALUES (X'00ff', -2)"),
+         "INSERT INTO t VALUES (?, -?)");
+  expect(fingerprint("INSERT INTO t VALUES (1, 2), (3, 4)"),
+         "INSERT INTO t VALUES (?, ?), (?, ?)");
+  expect(fingerprint("SELECT max(a, 1, 2) FROM t WHERE b NOT in(1, 2)"),
+         "SELECT max(a, ?, ?) FROM t WHERE b NOT in(?)");
+  expect(fingerprint("SELECT coin(1, 2) FROM t"), "SELECT coin(?, ?) FROM t");
+
+  Database db(":memory:");
+  Item it;
+  createTable(it).execute(db);
+
+  if (db.profiler()) throw std::runtime_error("Profiler is on by default");
+  insertInto(it).values(1, "a"s, 1.0).execute(db);
+
+  auto& profiler = db.startProfiling(std::chrono::nanoseconds(0), 2);
+  for (int i = 2; i <= 10; ++i)
+    insertInto(it).values(i, "item"s, i * 1.5).execute(db);
+  for (int i = 0; i < 3; ++i) {
+    auto res = select(it.name).where(it.price > 4.0).executeT(db);
+    while (res.hasData()) res.next();
+  }
+
+  auto profiles = profiler.snapshot();
+  if (profiles.size() != 2) throw std::runtime_error("Unexpected profiles");
+  for (const auto& p : profiles) {
+    if (p.total.count() <= 0 || p.p50 > p.p99 || p.p99 > p.total)
+      throw std::runtime_error("Unexpected latency of " + p.fingerprint);
+    if (p.fingerprint ==
+        "SELECT Items.name FROM Items WHERE Items.price > ?") {
+      if (p.calls != 3 || p.rows != 24)
+        throw std::runtime_error("Unexpected select profile");
+    } else if (p.fingerprint == "INSERT INTO Items VALUES (?, ?, ?)") {
+      if (p.calls != 9 || p.rows != 0)
+        throw std::runtime_error("Unexpected insert profile");
+    } else {
+      throw std::runtime_error("Unexpected fingerprint " + p.fingerprint);
+    }
+  }
+  if (profiler.snapshot(1).size() != 1)
+    throw std::runtime_error("Snapshot limit is ignored");
+
+  // Everything is slower than 0ns, only the latest statements are kept
+  auto slow = profiler.slowQueries();
+  if (slow.size() != 2 ||
+      slow.back().sql !=
+          "SELECT Items.name FROM Items WHERE Items.price > 4.0")
+    throw std::runtime_error("Unexpected slow query log");
+
+  profiler.report(std::cout);
+
+  profiler.reset();
+  if (!profiler.snapshot().empty() || !profiler.slowQueries().empty())
+    throw std::runtime_error("Profiler is not reset");
+
+  db.stopProfiling();
+  if (db.profiler()) throw std::runtime_error("Profiler is not stopped");
+  select(it.name).execute(db);
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,114 @@
+#include <sqlpp.h>
+
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <thread>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Event final : public Table<Event, int, std::string> {
+ public:
+  Event() : Table("Event", {"ts", "kind"}) {}
+
+  Column<0> ts = column<0>();
+  Column<1> kind = column<1>();
+};
+
+class Sample final : public Table<Sample, std::string, int, double> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0, 1>;
+  static constexpr bool WITHOUT_ROWID = true;
+
+  Sample() : Table("Sample", {"series", "ts", "value"}) {}
+
+  Column<0> series = column<0>();
+  Column<1> ts = column<1>();
+  Column<2> value = column<2>();
+};
+
+static int64_t rows(const Database& db, const std::string& table) {
+  auto res = db.execute("SELECT count(*) FROM " + table);
+  return res.as<Integer>(0).value();
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Event ev;
+  Sample smp;
+
+  createTable(ev).execute(db);
+  createTable(smp).execute(db);
+  for (int i = 0; i < 100; ++i) {
+    insertInto(ev).values(i, i % 2 ? "odd"s : "even"s).execute(db);
+    insertInto(smp).values("s"s, i, 0.5 * i).execute(db);
+  }
+
+  auto del = deleteFrom(ev).where(ev.kind == "odd"s && ev.ts > 90);
+  check(del, "DELETE FROM Event WHERE Event.kind = ? AND Event.ts > ?");
+  if (!del.execute(db) || rows(db, "Event") != 95)
+    throw std::runtime_error("Rows are not deleted");
+
+  auto ret = deleteFrom(ev).where(ev.ts == 0).returning(ev.kind);
+  check(ret, "DELETE FROM Event WHERE Event.ts = ? RETURNING Event.kind");
+  {
+    auto res = ret.executeT(db);
+    if (!res.hasData() || res.get<0>().value() != "even")
+      throw std::runtime_error("Deleted row is not returned");
+  }
+
+  size_t calls = 0;
+  auto progress = deleteFrom(ev).where(ev.ts < 50).purge(
+      db, 10, [&](const stmt::PurgeProgress& p) {
+        ++calls;
+        return p.rows == calls * 10 || p.rows == 49;
+      });
+  if (progress.rows != 49 || progress.chunks != 5 || calls != 5)
+    throw std::runtime_error("Unexpected purge progress");
+  if (rows(db, "Event") != 45)
+    throw std::runtime_error("Rows are not purged");
+
+  auto stopped = deleteFrom(ev).purge(db, 20, [](auto&) { return false; });
+  if (stopped.rows != 20 || rows(db, "Event") != 25)
+    throw std::runtime_error("Purge is not stopped");
+
+  auto keyed = deleteFrom(smp).where(smp.value >= 25.0).purge(db, 7);
+  if (keyed.rows != 50 || keyed.chunks != 8 || rows(db, "Sample") != 50)
+    throw std::runtime_error("Rows are not purged by key");
+
+  // Another connection holds the write lock when the purge starts
+  auto path = std::filesystem::temp_directory_path() / "sqlpp_purge.db";
+  std::filesystem::remove(path);
+  {
+    Database fileDb(path.string());
+    createTable(ev).execute(fileDb);
+    for (int i = 0; i < 30; ++i) insertInto(ev).values(i, "x"s).execute(fileDb);
+
+    Database other(path.string());
+    std::promise<void> locked;
+    std::thread writer([&] {
+      other.execute("BEGIN IMMEDIATE");
+      locked.set_value();
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      other.execute("COMMIT");
+    });
+    locked.get_future().wait();
+    auto busy = deleteFrom(ev).purge(fileDb, 10);
+    writer.join();
+    if (busy.rows != 30 || rows(fileDb, "Event") != 0)
+      throw std::runtime_error("Purge does not wait for the write lock");
+  }
+  std::filesystem::remove(path);
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
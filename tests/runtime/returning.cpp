@@ -0,0 +1,74 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Account final : public Table<Account, int, std::string, double> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0>;
+
+  Account() : Table("Account", {"id", "owner", "balance"}) {
+    setDefault<2>(0.0);
+  }
+
+  Column<0> id = column<0>();
+  Column<1> owner = column<1>();
+  Column<2> balance = column<2>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Account acc;
+
+  createTable(acc).execute(db);
+
+  auto ins = insertValues(acc.owner <<= "ann"s).returning(acc.id, acc.balance);
+  static_assert(std::is_same_v<decltype(ins)::Values,
+                               types::List<int, double>>);
+  check(ins,
+        "INSERT INTO Account (owner) VALUES (?) RETURNING Account.id, "
+        "Account.balance");
+  auto res = ins.executeT(db);
+  if (!res.hasData() || res.get<0>().value() != 1 ||
+      res.get<1>().value() != 0.0)
+    throw std::runtime_error("Unexpected inserted row");
+
+  auto row = insertInto(acc).values(7, "bob"s, 10.0).returning(acc);
+  check(row, "INSERT INTO Account VALUES (?, ?, ?) RETURNING *");
+  auto res2 = row.executeT(db);
+  if (!res2.hasData() || res2.get<1>().value() != "bob")
+    throw std::runtime_error("Unexpected inserted row");
+
+  auto upd = update(acc.balance = acc.balance + 5.0)
+                 .where(acc.owner == "bob"s)
+                 .returning(acc.id, acc.balance * 2.0);
+  check(upd,
+        "UPDATE Account SET balance = Account.balance + ? WHERE "
+        "Account.owner = ? RETURNING Account.id, Account.balance * ?");
+  auto res3 = upd.executeT(db);
+  if (!res3.hasData() || res3.get<0>().value() != 7 ||
+      res3.get<1>().value() != 30.0)
+    throw std::runtime_error("Unexpected updated row");
+  res3.next();
+  if (res3.hasData()) throw std::runtime_error("Unexpected extra row");
+
+  auto all = update(acc.balance = acc.balance * 0.5).returning(acc.owner);
+  check(all,
+        "UPDATE Account SET balance = Account.balance * ? RETURNING "
+        "Account.owner");
+  size_t count = 0;
+  for (auto r = all.executeT(db); r.hasData(); r.next()) ++count;
+  if (count != 2) throw std::runtime_error("Unexpected updated rows count");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -13,3 +13,25 @@ endmacro(add_run_test)
 
 add_run_test(basic)
 add_run_test(custom_type)
+add_run_test(constraints)
+add_run_test(join)
+add_run_test(in_set)
+add_run_test(aggregate)
+add_run_test(pager)
+add_run_test(subquery)
+add_run_test(returning)
+add_run_test(upsert)
+add_run_test(purge)
+add_run_test(insert_select)
+add_run_test(update_from)
+add_run_test(window)
+add_run_test(scalar)
+add_run_test(udf)
+add_run_test(sketch)
+add_run_test(explain)
+add_run_test(profiler)
+add_run_test(stmt_stats)
+add_run_test(metrics)
+add_run_test(timing)
+add_run_test(allocations)
+add_run_test(capture)
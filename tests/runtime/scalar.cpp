@@ -0,0 +1,87 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Person final : public Table<Person, int, std::string, double> {
+ public:
+  Person() : Table("Person", {"id", "name", "score"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> score = column<2>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Person p;
+
+  createTable(p).execute(db);
+  insertInto(p).values(1, "  Alice "s, -2.345).execute(db);
+  insertValues(p.id <<= 2, p.name <<= "Bob"s).execute(db);
+
+  auto text = select(length(p.name), upper(trim(p.name)), substr(p.name, 3, 3))
+                  .where(p.id == 1);
+  static_assert(std::is_same_v<decltype(text)::Values,
+                               types::List<Integer, Text, Text>>);
+  check(text,
+        "SELECT length(Person.name), upper(trim(Person.name)), "
+        "substr(Person.name, ?, ?) FROM Person WHERE Person.id = ?");
+  auto res = text.executeT(db);
+  if (!res.hasData() || res.get<0>().value() != 8 ||
+      res.get<1>().value() != "ALICE" || res.get<2>().value() != "Ali")
+    throw std::runtime_error("Unexpected text functions result");
+
+  auto num = select(abs(p.score), round(p.score, 1),
+                    coalesce(p.score, 0.5), max(p.id, 2, p.id * 3))
+                 .orderBy(p.id);
+  static_assert(std::is_same_v<decltype(num)::Values,
+                               types::List<Real, Real, Real, Integer>>);
+  check(num,
+        "SELECT abs(Person.score), round(Person.score, ?), "
+        "coalesce(Person.score, ?), max(Person.id, ?, Person.id * ?) FROM "
+        "Person ORDER BY Person.id");
+  auto res2 = num.executeT(db);
+  if (!res2.hasData() || res2.get<0>().value() != 2.345 ||
+      res2.get<1>().value() != -2.3 || res2.get<2>().value() != -2.345 ||
+      res2.get<3>().value() != 3)
+    throw std::runtime_error("Unexpected numeric functions result");
+  res2.next();
+  if (res2.get<0>().has_value() || res2.get<2>().value() != 0.5 ||
+      res2.get<3>().value() != 6)
+    throw std::runtime_error("Unexpected numeric functions result");
+
+  auto grade = caseWhen(p.score > 0.0, "good"s)
+                   .when(p.score < 0.0, "bad"s)
+                   .orElse(upper(p.name));
+  auto cases = select(p.id, grade).where(length(p.name) > 3);
+  check(cases,
+        "SELECT Person.id, CASE WHEN Person.score > ? THEN ? WHEN "
+        "Person.score < ? THEN ? ELSE upper(Person.name) END FROM Person "
+        "WHERE length(Person.name) > ?");
+  auto res3 = cases.executeT(db);
+  if (!res3.hasData() || res3.get<1>().value() != "bad")
+    throw std::runtime_error("Unexpected CASE result");
+  res3.next();
+  if (res3.hasData()) throw std::runtime_error("Unexpected CASE filter");
+
+  auto noElse = select(caseWhen(p.id == 2, p.score)).orderBy(p.id);
+  check(noElse,
+        "SELECT CASE WHEN Person.id = ? THEN Person.score END FROM Person "
+        "ORDER BY Person.id");
+  auto res4 = noElse.executeT(db);
+  if (!res4.hasData() || res4.get<0>().has_value())
+    throw std::runtime_error("Unexpected CASE without ELSE");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
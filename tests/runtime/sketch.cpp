@@ -0,0 +1,137 @@
+#include <sqlpp.h>
+
+#include <cmath>
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Visit final : public Table<Visit, int, int, std::string, std::string,
+                                 double> {
+ public:
+  Visit() : Table("Visits", {"id", "day", "user", "page", "latency"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> day = column<1>();
+  Column<2> user = column<2>();
+  Column<3> page = column<3>();
+  Column<4> latency = column<4>();
+};
+
+class Daily final : public Table<Daily, int, Blob, Blob> {
+ public:
+  Daily() : Table("Daily", {"day", "users", "latencies"}) {}
+
+  Column<0> day = column<0>();
+  Column<1> users = column<1>();
+  Column<2> latencies = column<2>();
+};
+
+static void near(double value, double expected, double tolerance,
+                 const std::string& what) {
+  std::cout << what << ": " << value << std::endl;
+  if (std::abs(value - expected) > tolerance)
+    throw std::runtime_error("Unexpected " + what);
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  registerSketches(db);
+  Visit v;
+  Daily d;
+
+  createTable(v).execute(db);
+  createTable(d).execute(db);
+
+  // 2000 distinct users split over 4 days, a third of the visits on "home"
+  db.execute("BEGIN");
+  for (int i = 0; i < 8000; ++i) {
+    auto page = i % 3 == 0 ? "home"s : "p" + std::to_string(i % 500);
+    insertInto(v)
+        .values(i, i % 4, "u" + std::to_string(i % 2000), page,
+                double(i % 1000))
+        .execute(db);
+  }
+  db.execute("COMMIT");
+
+  auto totals = select(approxCountDistinct(v.user),
+                       approxQuantile(v.latency, 0.5), approxTopK(v.page, 2));
+  check(totals,
+        "SELECT approx_count_distinct(Visits.user), "
+        "approx_quantile(Visits.latency, ?), approx_top_k(Visits.page, ?) "
+        "FROM Visits");
+  static_assert(std::is_same_v<decltype(totals)::Values,
+                               types::List<Integer, Real, Text>>);
+  auto res = totals.executeT(db);
+  near(res.get<0>().value(), 2000, 100, "distinct count");
+  near(res.get<1>().value(), 499.5, 10, "median");
+  auto top = res.get<2>().value();
+  std::cout << top << std::endl;
+  if (top.find("{\"value\":\"home\",\"count\":2667}") != 1)
+    throw std::runtime_error("Heavy hitter not found");
+
+  // Sketches stored per group and merged later
+  auto store = insertInto(d).from(
+      select(v.day, hllSketch(v.user), tdigestSketch(v.latency))
+          .groupBy(v.day));
+  check(store,
+        "INSERT INTO Daily SELECT Visits.day, hll_sketch(Visits.user), "
+        "tdigest_sketch(Visits.latency) FROM Visits GROUP BY Visits.day");
+  store.execute(db);
+
+  auto perDay = select(hllEstimate(d.users)).where(d.day == 1).executeT(db);
+  near(perDay.get<0>().value(), 500, 25, "daily distinct count");
+
+  auto merged = select(hllEstimate(hllMerge(d.users)),
+                       tdigestQuantile(tdigestMerge(d.latencies), 0.9));
+  check(merged,
+        "SELECT hll_estimate(hll_merge(Daily.users)), "
+        "tdigest_quantile(tdigest_merge(Daily.latencies), ?) FROM Daily");
+  auto res2 = merged.executeT(db);
+  near(res2.get<0>().value(), 2000, 100, "merged distinct count");
+  near(res2.get<1>().value(), 899.5, 10, "merged 0.9 quantile");
+
+  // Serialized sketches round trip
+  sketch::TopK items(4);
+  for (int i = 0; i < 100; ++i) items.add(i % 2 ? std::to_string(i) : "a");
+  auto copy = sketch::TopK::deserialize(items.serialize());
+  if (copy.top(1).front().value != "a" || copy.top(1).front().count < 50)
+    throw std::runtime_error("Unexpected top-k round trip");
+
+  sketch::TDigest digest;
+  if (!std::isnan(digest.quantile(0.5)))
+    throw std::runtime_error("Empty digest has a quantile");
+  for (int i = 1; i <= 1000; ++i) digest.add(i);
+  auto digest2 = sketch::TDigest::deserialize(digest.serialize());
+  near(digest2.quantile(0.0), 1, 0, "min");
+  near(digest2.quantile(1.0), 1000, 0, "max");
+  near(digest2.count(), 1000, 0, "count");
+
+  // The merged extremes come from the inputs, not from their centroids
+  sketch::TDigest low(10), high(10);
+  for (int i = 1; i <= 1000; ++i) low.add(i);
+  for (int i = 1001; i <= 2000; ++i) high.add(i);
+  sketch::TDigest both(10);
+  both.merge(sketch::TDigest::deserialize(low.serialize()));
+  both.merge(sketch::TDigest::deserialize(high.serialize()));
+  near(both.quantile(1.0), 2000, 0, "merged max");
+  near(both.quantile(0.0), 1, 0, "merged min");
+
+  try {
+    sketch::HyperLogLog::deserialize(items.serialize());
+    throw std::logic_error("Invalid sketch is accepted");
+  } catch (const std::runtime_error&) {
+  }
+  if (select(hllEstimate(d.latencies)).executeT(db))
+    throw std::runtime_error("Invalid sketch is accepted by SQL");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,20 @@
+#ifndef TESTS_RUNTIME_SQL_CHECK_H_
+#define TESTS_RUNTIME_SQL_CHECK_H_
+
+#include <sqlpp.h>
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+// Fails when the statement renders other SQL than expected
+inline void check(const sqlpp::Statement& stmt, const std::string& expected) {
+  std::ostringstream ss;
+  ss << stmt;
+  std::cout << ss.str() << std::endl;
+  if (ss.str() != expected)
+    throw std::runtime_error("Unexpected SQL, expected: " + expected);
+}
+
+#endif /* TESTS_RUNTIME_SQL_CHECK_H_ */
@@ -0,0 +1,82 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Node final : public Table<Node, int, std::string, int> {
+ public:
+  Node() : Table("Nodes", {"id", "name", "parent"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> parent = column<2>();
+};
+
+class Link final : public Table<Link, int, int> {
+ public:
+  Link() : Table("Links", {"source", "target"}) {}
+
+  Column<0> source = column<0>();
+  Column<1> target = column<1>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Node n;
+  Link l;
+  createTable(n).execute(db);
+  createTable(l).execute(db);
+
+  db.execute("BEGIN");
+  for (int i = 0; i < 200; ++i) {
+    insertInto(n).values(i, "n" + std::to_string(i), i / 2).execute(db);
+    insertInto(l).values(i, (i * 7) % 200).execute(db);
+  }
+  db.execute("COMMIT");
+
+  auto sorted = select(n.name).orderBy(n.parent).executeT(db);
+  while (sorted.hasData()) sorted.next();
+  auto stats = sorted.stats();
+  std::cout << "fullscan " << stats.fullscanSteps << " sorts " << stats.sorts
+            << " vm " << stats.vmSteps << " memory " << stats.memoryUsed
+            << std::endl;
+  if (stats.sorts != 1 || stats.fullscanSteps != 199 || stats.vmSteps == 0 ||
+      stats.runs != 1 || stats.autoindexes != 0 || stats.memoryUsed == 0)
+    throw std::runtime_error("Unexpected statement stats");
+
+  auto& profiler = db.startProfiling();
+  for (int i = 0; i < 2; ++i) {
+    // No index on Links.source, SQLite builds an automatic one for the join
+    auto res = select(n.name, l.target)
+                   .join(l)
+                   .on(l.source == n.id)
+                   .where(n.parent > 10)
+                   .executeT(db);
+    while (res.hasData()) res.next();
+    if (res.stats().autoindexes == 0)
+      throw std::runtime_error("Automatic index is not reported");
+  }
+  select(n.name).where(n.id == 5).execute(db);
+
+  auto profiles = profiler.snapshot();
+  profiler.report(std::cout);
+  if (profiles.size() != 2) throw std::runtime_error("Unexpected profiles");
+  for (const auto& p : profiles) {
+    bool join = p.fingerprint.find("JOIN") != std::string::npos;
+    if (join && (p.stats.autoindexes != 2 * 199 || p.stats.runs != 2 ||
+                 p.stats.sorts != 0))
+      throw std::runtime_error("Unexpected join stats");
+    if (!join && (p.stats.autoindexes != 0 || p.stats.runs != 1))
+      throw std::runtime_error("Unexpected lookup stats");
+  }
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,117 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Dept final : public Table<Dept, int, std::string> {
+ public:
+  Dept() : Table("Dept", {"id", "name"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+};
+
+class Emp final : public Table<Emp, int, int, int, std::string> {
+ public:
+  Emp() : Table("Emp", {"id", "manager", "dept", "name"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> manager = column<1>();
+  Column<2> dept = column<2>();
+  Column<3> name = column<3>();
+};
+
+class Chain final : public Table<Chain, int, int> {
+ public:
+  Chain() : Table("Chain", {"id", "depth"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> depth = column<1>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Dept dept;
+  Emp emp;
+  Chain chain;
+
+  createTable(dept).execute(db);
+  createTable(emp).execute(db);
+
+  insertInto(dept).values(1, "Board"s).execute(db);
+  insertInto(dept).values(2, "Sales"s).execute(db);
+  insertInto(dept).values(3, "Empty"s).execute(db);
+  insertInto(emp).values(1, 0, 1, "Boss"s).execute(db);
+  insertInto(emp).values(2, 1, 2, "Head of sales"s).execute(db);
+  insertInto(emp).values(3, 2, 2, "Seller"s).execute(db);
+  insertInto(emp).values(4, 2, 2, "Trainee"s).execute(db);
+  insertInto(emp).values(5, 0, 1, "Advisor"s).execute(db);
+
+  auto staff =
+      select(dept.name,
+             scalar(select(count(emp)).where(emp.dept == dept.id), dept))
+          .orderBy(dept.id);
+  check(staff,
+        "SELECT Dept.name, (SELECT count(*) FROM Emp WHERE Emp.dept = "
+        "Dept.id) FROM Dept ORDER BY Dept.id");
+  auto res = staff.executeT(db);
+  std::vector<Integer> counts;
+  for (; res.hasData(); res.next()) counts.push_back(res.get<1>().value());
+  if (counts != std::vector<Integer>{2, 3, 0})
+    throw std::runtime_error("Unexpected scalar subquery values");
+
+  auto busy = select(dept.name).where(
+      exists(select(emp.id).where(emp.dept == dept.id && emp.manager > 1),
+             dept));
+  auto res2 = busy.executeT(db);
+  if (!res2.hasData() || res2.get<0>().value() != "Sales")
+    throw std::runtime_error("Unexpected exists result");
+  res2.next();
+  if (res2.hasData()) throw std::runtime_error("Unexpected exists row");
+
+  auto start = select(emp.id, expr::Literal<Integer>(0)).where(emp.id == 2);
+  auto step = select(emp.id, chain.depth + 1)
+                  .join(chain)
+                  .on(emp.manager == chain.id);
+  auto tree = withRecursive(chain, start.unionAll(step))
+                  .select(emp.name, chain.depth)
+                  .join(chain)
+                  .on(chain.id == emp.id)
+                  .orderBy(chain.depth, emp.id);
+  check(tree,
+        "WITH RECURSIVE Chain(id, depth) AS (SELECT Emp.id, ? FROM Emp WHERE "
+        "Emp.id = ? UNION ALL SELECT Emp.id, Chain.depth + ? FROM Emp JOIN "
+        "Chain ON Emp.manager = Chain.id) SELECT Emp.name, Chain.depth FROM "
+        "Emp JOIN Chain ON Chain.id = Emp.id ORDER BY Chain.depth, Emp.id");
+  auto res3 = tree.executeT(db);
+  std::vector<std::string> names;
+  for (; res3.hasData(); res3.next()) names.push_back(res3.get<0>().value());
+  if (names != std::vector<std::string>{"Head of sales", "Seller", "Trainee"})
+    throw std::runtime_error("Unexpected recursive result");
+
+  auto both = select(emp.name)
+                  .where(emp.dept == 1)
+                  .unionDistinct(select(dept.name).where(dept.id == 1));
+  size_t rows = 0;
+  for (auto res4 = both.executeT(db); res4.hasData(); res4.next()) ++rows;
+  if (rows != 3) throw std::runtime_error("Unexpected union row count");
+
+  // WITH can only start the whole statement
+  try {
+    select(dept.name).unionAll(with(chain, start).select(emp.name));
+    throw std::logic_error("WITH is accepted in a compound select");
+  } catch (const std::runtime_error&) {
+  }
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,69 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Sample final : public Table<Sample, int, std::string> {
+ public:
+  Sample() : Table("Samples", {"id", "name"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+};
+
+static uint64_t sinkCalls = 0;
+
+static void sink(timing::Phase, std::chrono::nanoseconds) { ++sinkCalls; }
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Sample s;
+  createTable(s).execute(db);
+
+  timing::reset();
+  timing::setSink(sink);
+
+  insertInto(s).values(1, "one"s).execute(db);
+  auto res = select(s.name).where(s.id == 1 && s.name != "two"s).executeT(db);
+  if (res.get<0>().value() != "one")
+    throw std::runtime_error("Unexpected value");
+
+  const auto& counters = timing::counters();
+  uint64_t total = 0;
+  for (size_t i = 0; i < timing::PHASES; ++i) {
+    auto phase = static_cast<timing::Phase>(i);
+    std::cout << timing::name(phase) << ": " << counters.calls[i] << " calls "
+              << counters.time[i].count() << "ns" << std::endl;
+    if (timing::ENABLED && counters.calls[i] == 0)
+      throw std::runtime_error("Phase is not measured: "s +
+                               timing::name(phase));
+    total += counters.calls[i];
+  }
+  if (sinkCalls != total)
+    throw std::runtime_error("Sink calls differ from the counters");
+  if (!timing::ENABLED && total != 0)
+    throw std::runtime_error("Timing hooks are compiled in");
+
+  // Two statements prepared, bound and rendered once each
+  using timing::Phase;
+  if (timing::ENABLED &&
+      (counters.calls[static_cast<size_t>(Phase::PREPARE)] != 2 ||
+       counters.calls[static_cast<size_t>(Phase::RENDER)] != 2 ||
+       counters.calls[static_cast<size_t>(Phase::DECODE)] != 1))
+    throw std::runtime_error("Unexpected phase counts");
+
+  timing::setSink(nullptr);
+  timing::reset();
+  if (timing::counters().calls[0] != 0)
+    throw std::runtime_error("Counters are not reset");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,125 @@
+#include <sqlite3.h>
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Purchase final : public Table<Purchase, int, std::string, double> {
+ public:
+  Purchase() : Table("Orders", {"id", "customer", "total"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> customer = column<1>();
+  Column<2> total = column<2>();
+};
+
+struct Spread {
+  double min = 0.0;
+  double max = 0.0;
+  bool empty = true;
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Purchase o;
+
+  createTable(o).execute(db);
+  insertInto(o).values(1, "ann"s, 10.0).execute(db);
+  insertInto(o).values(2, "bob"s, 250.0).execute(db);
+  insertInto(o).values(3, "ann"s, 40.0).execute(db);
+  insertValues(o.id <<= 4, o.customer <<= "bob"s).execute(db);
+
+  auto discount = db.registerFunction(
+      "discount",
+      [](double total, int percent) { return total * (100 - percent) / 100; },
+      true);
+  auto vip = db.registerFunction("is_vip", [](const std::string& name) {
+    return name == "bob" ? 1 : 0;
+  });
+  auto fail = db.registerFunction("fail", [](int) -> int {
+    throw std::runtime_error("Failed on purpose");
+  });
+
+  auto stmt = select(o.id, discount(o.total, 10))
+                  .where(vip(o.customer) == 1 && o.total > 0.0);
+  static_assert(std::is_same_v<decltype(stmt)::Values,
+                               types::List<int, Real>>);
+  check(stmt,
+        "SELECT Orders.id, discount(Orders.total, ?) FROM Orders WHERE "
+        "is_vip(Orders.customer) = ? AND Orders.total > ?");
+  auto res = stmt.executeT(db);
+  if (!res.hasData() || res.get<0>().value() != 2 ||
+      res.get<1>().value() != 225.0)
+    throw std::runtime_error("Unexpected function result");
+  res.next();
+  if (res.hasData()) throw std::runtime_error("Unexpected extra row");
+
+  // NULL argument gives NULL without calling the function
+  auto nulls = select(discount(o.total, 10)).where(o.id == 4).executeT(db);
+  if (!nulls.hasData() || nulls.get<0>().has_value())
+    throw std::runtime_error("NULL argument is not handled");
+
+  if (select(fail(o.id)).executeT(db))
+    throw std::runtime_error("Function error is ignored");
+
+  // Other exceptions do not unwind through SQLite
+  auto odd = db.registerFunction("odd", [](int) -> int { throw 1; });
+  if (select(odd(o.id)).executeT(db) ||
+      sqlite3_errmsg(db.handle()) != "Unknown error in odd"s)
+    throw std::runtime_error("Unknown function error is not reported");
+  auto oddTotal = db.registerAggregate<Spread>(
+      "odd_total", [](Spread&, double) {},
+      [](const Spread&) -> double { throw 1; });
+  if (select(oddTotal(o.total)).executeT(db) ||
+      sqlite3_errmsg(db.handle()) != "Unknown error in odd_total"s)
+    throw std::runtime_error("Unknown aggregate error is not reported");
+
+  // Only functions registered as deterministic are allowed in indexes
+  db.execute("CREATE INDEX Discounted ON Orders(discount(total, 10))");
+  bool rejected = false;
+  try {
+    db.execute("CREATE INDEX Vip ON Orders(is_vip(customer))");
+  } catch (const std::runtime_error&) {
+    rejected = true;
+  }
+  if (!rejected)
+    throw std::runtime_error("Function is deterministic by default");
+
+  auto spread = db.registerAggregate<Spread>(
+      "spread",
+      [](Spread& s, double v) {
+        if (s.empty || v < s.min) s.min = v;
+        if (s.empty || v > s.max) s.max = v;
+        s.empty = false;
+      },
+      [](const Spread& s) { return s.max - s.min; });
+
+  auto groups = select(o.customer, spread(o.total))
+                    .groupBy(o.customer)
+                    .orderBy(o.customer);
+  check(groups,
+        "SELECT Orders.customer, spread(Orders.total) FROM Orders GROUP BY "
+        "Orders.customer ORDER BY Orders.customer");
+  auto res2 = groups.executeT(db);
+  if (!res2.hasData() || res2.get<1>().value() != 30.0)
+    throw std::runtime_error("Unexpected aggregate result");
+  res2.next();
+  if (!res2.hasData() || res2.get<1>().value() != 0.0)
+    throw std::runtime_error("Unexpected aggregate result");
+
+  auto empty = select(spread(o.total)).where(o.id > 10).executeT(db);
+  if (!empty.hasData() || empty.get<0>().value() != 0.0)
+    throw std::runtime_error("Unexpected aggregate of no rows");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
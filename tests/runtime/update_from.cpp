@@ -0,0 +1,85 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Stock final : public Table<Stock, int, std::string, int> {
+ public:
+  Stock() : Table("Stock", {"id", "name", "amount"}) {}
+
+  Column<0> id = column<0>();
+  Column<1> name = column<1>();
+  Column<2> amount = column<2>();
+};
+
+class Delta final : public Table<Delta, int, int> {
+ public:
+  Delta() : Table("Delta", {"stock", "change"}) {}
+
+  Column<0> stock = column<0>();
+  Column<1> change = column<1>();
+};
+
+class Rename final : public Table<Rename, int, std::string> {
+ public:
+  Rename() : Table("Rename", {"stock", "name"}) {}
+
+  Column<0> stock = column<0>();
+  Column<1> name = column<1>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Stock st;
+  Delta dt;
+  Rename rn;
+
+  createTable(st).execute(db);
+  createTable(dt).execute(db);
+  createTable(rn).execute(db);
+  for (int i = 0; i < 4; ++i) {
+    insertInto(st).values(i, "item"s, 10).execute(db);
+    if (i % 2) insertInto(dt).values(i, i * 5).execute(db);
+  }
+  insertInto(rn).values(2, "renamed"s).execute(db);
+
+  auto upd = update(st.amount = st.amount + dt.change)
+                 .from(dt)
+                 .where(dt.stock == st.id)
+                 .returning(st.id, st.amount);
+  check(upd,
+        "UPDATE Stock SET amount = Stock.amount + Delta.change FROM Delta "
+        "WHERE Delta.stock = Stock.id RETURNING Stock.id, Stock.amount");
+  int total = 0;
+  for (auto res = upd.executeT(db); res.hasData(); res.next())
+    total += res.get<0>().value() * res.get<1>().value();
+  // Rows 1 and 3 are changed to 15 and 25
+  if (total != 1 * 15 + 3 * 25)
+    throw std::runtime_error("Unexpected updated rows");
+
+  auto both = update(st.name = rn.name, st.amount = st.amount * dt.change)
+                  .from(rn, dt)
+                  .where(rn.stock == st.id && dt.stock == st.id + 1);
+  check(both,
+        "UPDATE Stock SET name = Rename.name, amount = Stock.amount * "
+        "Delta.change FROM Rename, Delta WHERE Rename.stock = Stock.id AND "
+        "Delta.stock = Stock.id + ?");
+  if (!both.execute(db)) throw std::runtime_error("Update is not executed");
+
+  auto res = select(st.name, st.amount).where(st.id == 2).executeT(db);
+  if (!res.hasData() || res.get<0>().value() != "renamed" ||
+      res.get<1>().value() != 150)
+    throw std::runtime_error("Unexpected updated row");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
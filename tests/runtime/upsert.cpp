@@ -0,0 +1,84 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Counter final : public Table<Counter, std::string, int, double> {
+ public:
+  using PrimaryKey = sqlpp::PrimaryKey<0>;
+
+  Counter() : Table("Counter", {"name", "hits", "weight"}) {}
+
+  Column<0> name = column<0>();
+  Column<1> hits = column<1>();
+  Column<2> weight = column<2>();
+};
+
+static int hits(const Database& db, const Counter& c, const std::string& n) {
+  auto res = select(c.hits).where(c.name == n).executeT(db);
+  if (!res.hasData()) throw std::runtime_error("Row is not found: " + n);
+  return res.get<0>().value();
+}
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Counter c;
+
+  createTable(c).execute(db);
+
+  auto ignore = insertInto(c).values("a"s, 1, 1.0).onConflict().doNothing();
+  check(ignore, "INSERT INTO Counter VALUES (?, ?, ?) ON CONFLICT DO NOTHING");
+  if (!ignore.execute(db) || !ignore.execute(db))
+    throw std::runtime_error("Upsert is not executed");
+  if (hits(db, c, "a") != 1)
+    throw std::runtime_error("Conflicting row is updated");
+
+  auto merge = insertValues(c.name <<= "a"s, c.hits <<= 1, c.weight <<= 2.0)
+                   .onConflict(c.name)
+                   .doUpdate(c.hits = c.hits + excluded(c.hits),
+                             c.weight = excluded(c.weight));
+  check(merge,
+        "INSERT INTO Counter (name, hits, weight) VALUES (?, ?, ?) ON "
+        "CONFLICT (name) DO UPDATE SET hits = Counter.hits + excluded.hits, "
+        "weight = excluded.weight");
+  merge.execute(db);
+  merge.execute(db);
+  if (hits(db, c, "a") != 3)
+    throw std::runtime_error("Conflicting row is not updated");
+
+  auto guarded = insertInto(c)
+                     .values("a"s, 10, 0.5)
+                     .onConflict(c.name)
+                     .doUpdate(c.hits = excluded(c.hits))
+                     .where(excluded(c.weight) > c.weight * 0.5)
+                     .returning(c.hits);
+  check(guarded,
+        "INSERT INTO Counter VALUES (?, ?, ?) ON CONFLICT (name) DO UPDATE "
+        "SET hits = excluded.hits WHERE excluded.weight > Counter.weight * ? "
+        "RETURNING Counter.hits");
+  if (guarded.executeT(db).hasData())
+    throw std::runtime_error("Update condition is ignored");
+  if (hits(db, c, "a") != 3)
+    throw std::runtime_error("Update condition is ignored");
+
+  auto fresh = insertInto(c)
+                   .values("b"s, 10, 0.5)
+                   .onConflict(c.name)
+                   .doUpdate(c.hits = excluded(c.hits))
+                   .returning(c.hits);
+  auto res = fresh.executeT(db);
+  if (!res.hasData() || res.get<0>().value() != 10)
+    throw std::runtime_error("New row is not inserted");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}
@@ -0,0 +1,79 @@
+#include <sqlpp.h>
+
+#include <iostream>
+
+#include "sql_check.h"
+
+using namespace sqlpp;
+using namespace std::string_literals;
+
+class Reading final : public Table<Reading, std::string, int, double> {
+ public:
+  Reading() : Table("Reading", {"sensor", "ts", "value"}) {}
+
+  Column<0> sensor = column<0>();
+  Column<1> ts = column<1>();
+  Column<2> value = column<2>();
+};
+
+int main(int argc, char* argv[]) try {
+  Database db(":memory:");
+  Reading rd;
+
+  createTable(rd).execute(db);
+  for (int i = 1; i <= 4; ++i) {
+    insertInto(rd).values("a"s, i, 1.0 * i).execute(db);
+    insertInto(rd).values("b"s, i, 10.0 * i).execute(db);
+  }
+
+  auto stmt =
+      select(rd.sensor, rd.ts,
+             rowNumber().over(partitionBy(rd.sensor), orderBy(desc(rd.ts))),
+             sum(rd.value).over(partitionBy(rd.sensor), orderBy(rd.ts)),
+             avg(rd.value).over(partitionBy(rd.sensor), orderBy(rd.ts),
+                                rowsBetween(preceding(1), currentRow())),
+             lag(rd.value, 1, -1.0).over(orderBy(rd.sensor, rd.ts)))
+          .where(rd.ts >= 2)
+          .orderBy(rd.sensor, rd.ts);
+  static_assert(std::is_same_v<decltype(stmt)::Values,
+                               types::List<std::string, int, Integer, Real,
+                                           Real, Real>>);
+  check(stmt,
+        "SELECT Reading.sensor, Reading.ts, row_number() OVER (PARTITION BY "
+        "Reading.sensor ORDER BY Reading.ts DESC), sum(Reading.value) OVER "
+        "(PARTITION BY Reading.sensor ORDER BY Reading.ts), "
+        "avg(Reading.value) OVER (PARTITION BY Reading.sensor ORDER BY "
+        "Reading.ts ROWS BETWEEN 1 PRECEDING AND CURRENT ROW), "
+        "lag(Reading.value, ?, ?) OVER (ORDER BY Reading.sensor, Reading.ts) "
+        "FROM Reading WHERE Reading.ts >= ? ORDER BY Reading.sensor, "
+        "Reading.ts");
+
+  auto res = stmt.executeT(db);
+  // Rows with ts >= 2 of sensor "a": 2, 3 and 4
+  if (!res.hasData() || res.get<1>().value() != 2 ||
+      res.get<2>().value() != 3 || res.get<3>().value() != 2.0 ||
+      res.get<4>().value() != 2.0 || res.get<5>().value() != -1.0)
+    throw std::runtime_error("Unexpected first row");
+  res.next();
+  if (res.get<3>().value() != 5.0 || res.get<4>().value() != 2.5 ||
+      res.get<5>().value() != 2.0)
+    throw std::runtime_error("Unexpected second row");
+
+  auto ranked = select(rd.sensor, rank().over(orderBy(sum(rd.value))))
+                    .groupBy(rd.sensor)
+                    .orderBy(rd.sensor);
+  check(ranked,
+        "SELECT Reading.sensor, rank() OVER (ORDER BY sum(Reading.value)) "
+        "FROM Reading GROUP BY Reading.sensor ORDER BY Reading.sensor");
+  auto res2 = ranked.executeT(db);
+  if (!res2.hasData() || res2.get<1>().value() != 1)
+    throw std::runtime_error("Unexpected rank");
+
+  return 0;
+} catch (const std::exception& e) {
+  std::cerr << "Error: " << e.what() << std::endl;
+  return 1;
+} catch (...) {
+  std::cerr << "Unknown error" << std::endl;
+  return 2;
+}